@@ -19,6 +19,10 @@
  *     ..
  *   };
  *
+ * Services whose provider is cheap to replicate can instead keep one
+ * provider per schedule with lar::PerScheduleProviders
+ * (larcore/CoreUtils/PerScheduleProviders.h).
+ *
  */
 
 namespace lar {
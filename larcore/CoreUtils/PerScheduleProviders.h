@@ -0,0 +1,276 @@
+/**
+ * @file   larcore/CoreUtils/PerScheduleProviders.h
+ * @brief  Service base class keeping a replica of its provider per schedule.
+ * @see    larcore/CoreUtils/EnsureOnlyOneSchedule.h
+ *
+ * This is a pure template library.
+ * The callers will need to link to:
+ *
+ * * `${ART_FRAMEWORK_SERVICES_REGISTRY}`
+ * * `${ART_UTILITIES}`
+ *
+ */
+
+#ifndef LARCORE_COREUTILS_PERSCHEDULEPROVIDERS_H
+#define LARCORE_COREUTILS_PERSCHEDULEPROVIDERS_H
+
+// LArSoft libraries
+#include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom() (for includers)
+
+// framework libraries
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
+#include "art/Framework/Services/Registry/ServiceTable.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Utilities/Globals.h"
+#include "canvas/Utilities/Exception.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <cstddef> // std::size_t
+#include <limits>
+#include <memory> // std::unique_ptr<>, std::make_unique()
+#include <utility> // std::move()
+#include <vector>
+
+
+namespace lar {
+
+  namespace details {
+
+    /// Value of `CurrentScheduleIndex` outside of any schedule.
+    inline constexpr std::size_t NoSchedule
+      = std::numeric_limits<std::size_t>::max();
+
+    /// Schedule of the module running on this thread (`NoSchedule` if none).
+    inline thread_local std::size_t CurrentScheduleIndex = NoSchedule;
+
+    /// Schedules of the modules interrupted on this thread (innermost last).
+    inline thread_local std::vector<std::size_t> ScheduleIndexStack;
+
+  } // namespace details
+
+
+  /** **************************************************************************
+   * @brief Service base class with one replica of the provider per schedule.
+   * @tparam PROVIDER type of service provider
+   * @see lar::EnsureOnlyOneSchedule
+   *
+   * A service whose provider is not thread-safe, but is cheap to replicate,
+   * can inherit from this class instead of `lar::EnsureOnlyOneSchedule`:
+   * one replica of the provider is created for each art schedule, and
+   * `provider()` (and therefore `lar::providerFrom()`) returns the replica of
+   * the schedule of the module running on the calling thread, so that
+   * events processed concurrently never share a replica.
+   *
+   * The schedule is learnt from the `sPreModule` and `sPostModule` framework
+   * signals. A thread waiting for tasks within a module may run a module of
+   * another schedule meanwhile: the schedule of the interrupted module is
+   * restored when the other module ends.
+   * Code not running in a module event processing (e.g. on run transitions,
+   * and in tasks spawned by a module on other threads) gets an additional
+   * replica, which belongs to no schedule: this replica is not protected
+   * against concurrent use, and modules spawning tasks should pass them the
+   * provider they obtained instead.
+   *
+   * All replicas are created at construction by a function ("factory")
+   * taking the index of the schedule (`NoSchedule()` for the additional
+   * replica) and returning a `std::unique_ptr` to the new provider.
+   * Replicas can be updated together with `forEachReplica()`, when no event
+   * is being processed (e.g. on `sPreBeginRun`).
+   *
+   * Example of usage:
+   *
+   *     class MyService: public lar::PerScheduleProviders<MyProvider> {
+   *         public:
+   *       MyService
+   *         (fhicl::ParameterSet const& pset, art::ActivityRegistry& reg)
+   *         : lar::PerScheduleProviders<MyProvider>(reg,
+   *             [&pset](std::size_t)
+   *               { return std::make_unique<MyProvider>(pset); }
+   *           )
+   *         {}
+   *     };
+   *
+   * Since the provider depends on the calling thread,
+   * `lar::cachedProviderFrom()` does not cache it (see
+   * `per_schedule_provider`).
+   */
+  template <typename PROVIDER>
+  class PerScheduleProviders {
+
+      public:
+    using provider_type = PROVIDER; ///< type of the service provider
+
+    /// Informs `lar::cachedProviderFrom()` that the provider is per schedule.
+    static constexpr bool per_schedule_provider = true;
+
+
+    /**
+     * @brief Constructor: creates one replica per configured schedule.
+     * @tparam Factory type of function creating a replica
+     * @param reg the framework registry of callbacks
+     * @param makeReplica function creating the replica for a schedule index
+     * @throws art::Exception (`art::errors::Configuration`) if `makeReplica`
+     *         returns no provider
+     */
+    template <typename Factory>
+    PerScheduleProviders(art::ActivityRegistry& reg, Factory makeReplica)
+      : PerScheduleProviders
+          (reg, art::Globals::instance()->nschedules(), std::move(makeReplica))
+      {}
+
+    /**
+     * @brief Constructor: creates replicas for the specified schedules.
+     * @tparam Registry type of registry of the module callbacks
+     * @tparam Factory type of function creating a replica
+     * @param reg the registry of callbacks (`sPreModule`, `sPostModule`)
+     * @param nSchedules number of schedules
+     * @param makeReplica function creating the replica for a schedule index
+     * @throws art::Exception (`art::errors::Configuration`) if `makeReplica`
+     *         returns no provider
+     *
+     * The callbacks receive an object describing the module, whose
+     * `scheduleID().id()` is the index of the schedule.
+     */
+    template <typename Registry, typename Factory>
+    PerScheduleProviders
+      (Registry& reg, std::size_t nSchedules, Factory makeReplica)
+      : PerScheduleProviders(nSchedules, std::move(makeReplica))
+      {
+        reg.sPreModule.watch([](auto const& context)
+          { EnterSchedule(context.scheduleID().id()); });
+        reg.sPostModule.watch([](auto const&){ LeaveSchedule(); });
+      }
+
+    /**
+     * @brief Constructor: creates replicas for the specified schedules.
+     * @tparam Factory type of function creating a replica
+     * @param nSchedules number of schedules
+     * @param makeReplica function creating the replica for a schedule index
+     * @throws art::Exception (`art::errors::Configuration`) if `makeReplica`
+     *         returns no provider
+     *
+     * This constructor does not follow the schedule of the modules by itself:
+     * `provider()` selects the replica from `CurrentSchedule()`.
+     */
+    template <typename Factory>
+    PerScheduleProviders(std::size_t nSchedules, Factory makeReplica)
+      {
+        fReplicas.reserve(nSchedules + 1);
+        for (std::size_t iSchedule = 0; iSchedule <= nSchedules; ++iSchedule) {
+          std::size_t const index
+            = (iSchedule < nSchedules)? iSchedule: NoSchedule();
+          std::unique_ptr<provider_type> replica { makeReplica(index) };
+          if (!replica) {
+            throw art::Exception(art::errors::Configuration)
+              << "No service provider replica created for schedule #"
+              << index << ".\n";
+          }
+          fReplicas.push_back(std::move(replica));
+        } // for
+      }
+
+
+    /// Returns a constant pointer to the provider for the current schedule.
+    provider_type const* provider() const
+      { return replica(CurrentSchedule()); }
+
+    /// Returns the replica for the specified schedule (or the one for none).
+    provider_type const* replica(std::size_t iSchedule) const
+      { return fReplicas[std::min(iSchedule, nSchedules())].get(); }
+
+    /// Returns the number of schedules with their own replica.
+    std::size_t nSchedules() const { return fReplicas.size() - 1; }
+
+    /**
+     * @brief Applies `op` to each replica, in schedule order.
+     * @tparam Op type of operation
+     * @param op operation, taking the index of the schedule and the replica
+     *
+     * The replica for no schedule is the last one, with index `NoSchedule()`.
+     * This must be called only when no event is being processed.
+     */
+    template <typename Op>
+    void forEachReplica(Op op)
+      {
+        for (std::size_t iSchedule = 0; iSchedule < nSchedules(); ++iSchedule)
+          op(iSchedule, *(fReplicas[iSchedule]));
+        op(NoSchedule(), *(fReplicas.back()));
+      }
+
+    /// Returns the schedule of the module running on this thread.
+    static std::size_t CurrentSchedule()
+      { return details::CurrentScheduleIndex; }
+
+    /// Sets the schedule of this thread (`NoSchedule()` to leave it).
+    static void SetCurrentSchedule(std::size_t iSchedule)
+      { details::CurrentScheduleIndex = iSchedule; }
+
+    /// Makes `iSchedule` current on this thread, until `LeaveSchedule()`.
+    static void EnterSchedule(std::size_t iSchedule)
+      {
+        details::ScheduleIndexStack.push_back(details::CurrentScheduleIndex);
+        details::CurrentScheduleIndex = iSchedule;
+      }
+
+    /// Restores the schedule current before the last `EnterSchedule()`.
+    static void LeaveSchedule()
+      {
+        auto& stack = details::ScheduleIndexStack;
+        if (stack.empty()) {
+          details::CurrentScheduleIndex = details::NoSchedule;
+          return;
+        }
+        details::CurrentScheduleIndex = stack.back();
+        stack.pop_back();
+      }
+
+    /// Value of the schedule index outside of any schedule.
+    static constexpr std::size_t NoSchedule() { return details::NoSchedule; }
+
+
+      private:
+    /// Provider replicas, one per schedule plus the one for no schedule.
+    std::vector<std::unique_ptr<provider_type>> fReplicas;
+
+  }; // PerScheduleProviders<>
+
+
+  /** **************************************************************************
+   * @brief Service returning a provider replica per schedule.
+   * @tparam PROVIDER type of service provider to be returned
+   * @see lar::SimpleServiceProviderWrapper, lar::PerScheduleProviders
+   *
+   * This service is equivalent to `lar::SimpleServiceProviderWrapper`, but
+   * each schedule has its own provider, all created with the same
+   * configuration, as in `lar::PerScheduleProviders`.
+   *
+   * Requirements on the service provider are the same as for
+   * `lar::SimpleServiceProviderWrapper`.
+   */
+  template <typename PROVIDER>
+  class PerScheduleServiceProviderWrapper
+    : public lar::PerScheduleProviders<PROVIDER>
+  {
+
+      public:
+    using provider_type = PROVIDER; ///< type of the service provider
+
+    /// Type of configuration parameter (for art description)
+    using Parameters = art::ServiceTable<typename provider_type::Config>;
+
+    /// Constructor (using a configuration table)
+    PerScheduleServiceProviderWrapper
+      (Parameters const& config, art::ActivityRegistry& reg)
+      : lar::PerScheduleProviders<provider_type>(reg,
+          [&config](std::size_t)
+            { return std::make_unique<provider_type>(config()); }
+        )
+      {}
+
+  }; // PerScheduleServiceProviderWrapper<>
+
+} // namespace lar
+
+
+#endif // LARCORE_COREUTILS_PERSCHEDULEPROVIDERS_H
@@ -14,6 +14,11 @@
  * * SimpleServiceProviderWrapper: wrap a service with a single implementation
  * * ServiceProviderImplementationWrapper: wrap a concrete implementation of a
  *   service provider interface supporting multiple implementations
+ * * SwappableProviderHolder: owner of a provider which can be replaced while
+ *   other threads are using it
+ * * SwappableServiceProviderWrapper,
+ *   SwappableServiceProviderImplementationWrapper: versions of the wrappers
+ *   above whose provider can be replaced
  *
  */
 
@@ -25,11 +30,19 @@
 #include "larcore/CoreUtils/ServiceUtil.h" // lar::providerFrom() (for includers)
 
 // framework and support libraries
+#include "art/Framework/Services/Registry/ActivityRegistry.h"
 #include "art/Framework/Services/Registry/ServiceTable.h"
 #include "art/Framework/Services/Registry/ServiceMacros.h" // (for includers)
 
 // C/C++ standard libraries
-#include <memory> // std::unique_ptr<>
+#include <memory> // std::unique_ptr<>, std::shared_ptr<>, std::atomic_load()...
+#include <functional> // std::function<>
+#include <vector>
+#include <mutex>
+#include <cstddef> // std::size_t
+#include <atomic>
+#include <cstdint> // std::uint64_t
+#include <utility> // std::move()
 
 
 // forward declarations
@@ -269,6 +282,265 @@ namespace lar {
    }; // ServiceProviderImplementationWrapper
 
 
+
+   /** *************************************************************************
+    * @brief Owner of a service provider which can be replaced at any time
+    * @tparam PROVIDER type of service provider held
+    *
+    * The provider is shared: `providerSnapshot()` returns a shared pointer to
+    * the current one, which stays valid as long as the caller holds it, even
+    * if the provider is replaced (`Replace()`) meanwhile from another thread.
+    * The replacement is atomic, and callers see either the old or the new
+    * provider, never a partially built one.
+    *
+    * The plain pointer from `provider()` is instead guaranteed valid only
+    * until `ReleaseRetired()` is called after the provider is replaced: the
+    * holder keeps alive all the replaced providers until then, so that code
+    * which obtained the pointer before a replacement (e.g. in the middle of
+    * an event) can still complete. `ReleaseRetired()` must be called only
+    * when no such pointer can be in use anymore (the swappable service
+    * wrappers call it at the end of each run).
+    * On replacement, the providers cached by `lar::cachedProviderFrom()` are
+    * invalidated, the generation number (`Generation()`) is increased, and
+    * all the callbacks registered with `RegisterReloadCallback()` are called
+    * with the new provider, in the order they were registered.
+    * Replacements are serialized, and callbacks must not replace the
+    * provider nor register new callbacks.
+    */
+   template <typename PROVIDER>
+   class SwappableProviderHolder {
+
+         public:
+      using provider_type = PROVIDER; ///< type of the service provider
+
+      /// Type of shared pointer to the provider.
+      using provider_ptr_t = std::shared_ptr<provider_type const>;
+
+      /// Type of function called after each replacement of the provider.
+      using ReloadCallback_t = std::function<void(provider_type const&)>;
+
+
+      /// Constructor: holds no provider.
+      SwappableProviderHolder() = default;
+
+      /// Constructor: holds the specified provider.
+      explicit SwappableProviderHolder(provider_ptr_t provider)
+         : prov(std::move(provider))
+         {}
+
+
+      /// Returns a constant pointer to the current provider.
+      provider_type const* provider() const
+         { return std::atomic_load(&prov).get(); }
+
+      /// Returns a shared pointer to the current provider.
+      provider_ptr_t providerSnapshot() const
+         { return std::atomic_load(&prov); }
+
+      /// Returns the number of times the provider was replaced.
+      std::uint64_t Generation() const
+         { return generation.load(std::memory_order_acquire); }
+
+
+      /// Replaces the provider, then calls the reload callbacks.
+      void Replace(provider_ptr_t provider)
+         {
+            std::lock_guard<std::mutex> const lock { replaceMutex };
+            retired.push_back(std::atomic_exchange(&prov, provider));
+            generation.fetch_add(1U, std::memory_order_acq_rel);
+            lar::invalidateCachedProviders();
+            if (provider) {
+               for (ReloadCallback_t const& callback: callbacks)
+                  callback(*provider);
+            }
+         } // Replace()
+
+      /// Registers a function to be called after each provider replacement.
+      void RegisterReloadCallback(ReloadCallback_t callback)
+         {
+            std::lock_guard<std::mutex> const lock { replaceMutex };
+            callbacks.push_back(std::move(callback));
+         }
+
+      /// Releases the replaced providers (no pointer to them must be in use).
+      void ReleaseRetired()
+         {
+            std::lock_guard<std::mutex> const lock { replaceMutex };
+            retired.clear();
+         }
+
+      /// Returns the number of replaced providers still kept alive.
+      std::size_t NRetired() const
+         {
+            std::lock_guard<std::mutex> const lock { replaceMutex };
+            return retired.size();
+         }
+
+
+         private:
+      provider_ptr_t prov; ///< Current provider (atomic access only).
+      std::vector<provider_ptr_t> retired; ///< Replaced providers, kept alive.
+      std::atomic<std::uint64_t> generation { 0U }; ///< Replacement count.
+      std::vector<ReloadCallback_t> callbacks; ///< Reload callbacks.
+      /// Serializes replacements, registrations and releases.
+      mutable std::mutex replaceMutex;
+
+   }; // SwappableProviderHolder<>
+
+
+
+   /** **********************************************************************
+    * @brief Service returning a provider which can be replaced
+    * @tparam PROVIDER type of service provider to be returned
+    * @see SimpleServiceProviderWrapper, SwappableProviderHolder
+    *
+    * This service is equivalent to `SimpleServiceProviderWrapper`, but the
+    * provider can be replaced (`ReplaceProvider()`, `ReloadProvider()`) while
+    * other threads are using the old one, according to the rules of
+    * `SwappableProviderHolder`.
+    * A service deriving from this class can then replace the provider from
+    * a framework callback (e.g. on a new run) without restricting the job to
+    * a single schedule: code needing the same provider for a whole event
+    * should get it once per event, or hold `providerSnapshot()`.
+    * The replaced providers are released at the end of each run
+    * (`sPostEndRun`), when no event is being processed: pointers from
+    * `provider()` must not be kept across runs.
+    *
+    * Requirements on the service provider are the same as for
+    * `SimpleServiceProviderWrapper`.
+    */
+   template <class PROVIDER>
+   class SwappableServiceProviderWrapper {
+
+         public:
+      using provider_type = PROVIDER; ///< type of the service provider
+
+      /// Type of configuration parameter (for art description)
+      using Parameters = art::ServiceTable<typename provider_type::Config>;
+
+      /// Type of function called after each replacement of the provider.
+      using ReloadCallback_t
+         = typename SwappableProviderHolder<provider_type>::ReloadCallback_t;
+
+
+      /// Constructor (using a configuration table)
+      SwappableServiceProviderWrapper
+         (Parameters const& config, art::ActivityRegistry& reg)
+         : prov(std::make_shared<provider_type const>(config()))
+         {
+            reg.sPostEndRun.watch
+               ([this](auto const&){ prov.ReleaseRetired(); });
+         }
+
+
+      /// Returns a constant pointer to the current service provider
+      provider_type const* provider() const { return prov.provider(); }
+
+      /// Returns a shared pointer to the current service provider
+      std::shared_ptr<provider_type const> providerSnapshot() const
+         { return prov.providerSnapshot(); }
+
+      /// Returns the number of times the provider was replaced.
+      std::uint64_t Generation() const { return prov.Generation(); }
+
+      /// Replaces the service provider with the specified one.
+      void ReplaceProvider(std::shared_ptr<provider_type const> provider)
+         { prov.Replace(std::move(provider)); }
+
+      /// Replaces the service provider with one with a new configuration.
+      void ReloadProvider(typename provider_type::Config const& config)
+         { ReplaceProvider(std::make_shared<provider_type const>(config)); }
+
+      /// Registers a function to be called after each provider replacement.
+      void RegisterReloadCallback(ReloadCallback_t callback)
+         { prov.RegisterReloadCallback(std::move(callback)); }
+
+
+         private:
+
+      SwappableProviderHolder<provider_type> prov; ///< service provider
+
+   }; // SwappableServiceProviderWrapper<>
+
+
+
+   /** *************************************************************************
+    * @brief Service implementation returning a provider which can be replaced
+    * @tparam PROVIDER type of service provider to be returned
+    * @tparam INTERFACE type of art service being implemented
+    * @see ServiceProviderImplementationWrapper, SwappableProviderHolder
+    *
+    * This service is equivalent to `ServiceProviderImplementationWrapper`,
+    * but the provider can be replaced as in `SwappableServiceProviderWrapper`
+    * (replaced providers are also released at the end of each run).
+    */
+   template <typename PROVIDER, typename INTERFACE>
+   class SwappableServiceProviderImplementationWrapper: public INTERFACE {
+
+         public:
+      /// type of service provider implementation
+      using concrete_provider_type = PROVIDER;
+
+      /// art service interface class
+      using service_interface_type = INTERFACE;
+
+      /// type of service provider interface
+      using provider_type = typename service_interface_type::provider_type;
+
+      /// Type of configuration parameter (for art description)
+      using Parameters
+        = art::ServiceTable<typename concrete_provider_type::Config>;
+
+      /// Type of function called after each replacement of the provider.
+      using ReloadCallback_t = typename SwappableProviderHolder
+         <concrete_provider_type>::ReloadCallback_t;
+
+
+      /// Constructor (using a configuration table)
+      SwappableServiceProviderImplementationWrapper
+         (Parameters const& config, art::ActivityRegistry& reg)
+         : prov(std::make_shared<concrete_provider_type const>(config()))
+         {
+            reg.sPostEndRun.watch
+               ([this](auto const&){ prov.ReleaseRetired(); });
+         }
+
+
+      /// Returns a shared pointer to the current service provider
+      std::shared_ptr<concrete_provider_type const> providerSnapshot() const
+         { return prov.providerSnapshot(); }
+
+      /// Returns the number of times the provider was replaced.
+      std::uint64_t Generation() const { return prov.Generation(); }
+
+      /// Replaces the service provider with the specified one.
+      void ReplaceProvider
+         (std::shared_ptr<concrete_provider_type const> provider)
+         { prov.Replace(std::move(provider)); }
+
+      /// Replaces the service provider with one with a new configuration.
+      void ReloadProvider(typename concrete_provider_type::Config const& config)
+         {
+            ReplaceProvider
+               (std::make_shared<concrete_provider_type const>(config));
+         }
+
+      /// Registers a function to be called after each provider replacement.
+      void RegisterReloadCallback(ReloadCallback_t callback)
+         { prov.RegisterReloadCallback(std::move(callback)); }
+
+
+         private:
+      /// service provider
+      SwappableProviderHolder<concrete_provider_type> prov;
+
+      /// Returns a constant pointer to the service provider
+      virtual provider_type const* do_provider() const override
+         { return prov.provider(); }
+
+   }; // SwappableServiceProviderImplementationWrapper
+
+
 } // namespace lar
 
 
@@ -13,6 +13,9 @@
  *   services
  * - lar::providersFrom_t, a type defined as a provider pack with the providers
  *   from all the specified services
+ * - lar::cachedProviderFrom() and lar::cachedProvidersFrom(), same as above
+ *   but remembering the providers on each thread until
+ *   lar::invalidateCachedProviders() is called
  *
  */
 
@@ -29,7 +32,9 @@
 #include "cetlib_except/demangle.h"
 
 // C/C++ standard libraries
-#include <type_traits> // std::decay<>, std::is_same<>, std::add_const_t<>
+#include <atomic>
+#include <cstdint> // std::uint64_t
+#include <type_traits> // std::decay<>, std::is_same<>, std::enable_if_t<>...
 #include <typeinfo>
 
 
@@ -42,6 +47,19 @@ namespace lar {
     template <typename... Services>
     struct ProviderPackExtractor;
 
+    /// Version of the cached providers; changing it invalidates all of them.
+    inline std::atomic<std::uint64_t> ProviderCacheEpoch { 0U };
+
+    /// Whether `SERVICE` returns a different provider on each schedule.
+    template <typename SERVICE, typename = void>
+    struct hasPerScheduleProvider: std::false_type {};
+
+    template <typename SERVICE>
+    struct hasPerScheduleProvider
+      <SERVICE, std::enable_if_t<SERVICE::per_schedule_provider>>
+      : std::true_type
+    {};
+
   } // namespace details
 
 
@@ -142,6 +160,87 @@ namespace lar {
     = lar::ProviderPack<typename Services::provider_type...>;
 
 
+  /** **************************************************************************
+   * @brief Returns a constant pointer to the provider of specified service.
+   * @tparam T type of the service
+   * @return a constant pointer to the provider of specified service
+   * @throws art::Exception as lar::providerFrom()
+   * @see lar::providerFrom(), lar::invalidateCachedProviders()
+   *
+   * The result is the same as `lar::providerFrom()`, but the provider is
+   * asked to the service only at the first call on each thread: later calls
+   * return the same pointer, at the cost of two memory reads, until the
+   * cached providers are invalidated by `lar::invalidateCachedProviders()`.
+   * This is meant for code asking for the providers very often (e.g. in each
+   * event), and it relies on the services which replace their provider to
+   * call `lar::invalidateCachedProviders()` when they do so.
+   *
+   * Example of usage:
+   *
+   *     auto const* geom = lar::cachedProviderFrom<geo::Geometry>();
+   *
+   * Services which return a different provider on each schedule (declaring
+   * a `per_schedule_provider` constant set to `true`, like
+   * `lar::PerScheduleProviders`) are not cached, and their provider is
+   * always obtained via `lar::providerFrom()`.
+   *
+   * @note The cache only keeps the pointer to the provider valid.
+   *       Information derived from the provider content should be checked
+   *       on its own, if the provider offers a way (e.g. the geometry
+   *       `Generation()` number).
+   */
+  template <typename T>
+  typename T::provider_type const* cachedProviderFrom()
+    {
+      using Provider_t = typename std::add_const_t<T>::provider_type;
+
+      if constexpr (details::hasPerScheduleProvider<std::decay_t<T>>()) {
+        return lar::providerFrom<T>();
+      }
+      else {
+        thread_local std::uint64_t epoch = 0U;
+        thread_local Provider_t const* pProvider = nullptr;
+
+        std::uint64_t const current
+          = details::ProviderCacheEpoch.load(std::memory_order_acquire);
+        if (!pProvider || (epoch != current)) {
+          pProvider = lar::providerFrom<T>();
+          epoch = current;
+        }
+        return pProvider;
+      }
+
+    } // cachedProviderFrom()
+
+
+  /** **************************************************************************
+   * @brief Returns a lar::ProviderPack with providers from all services
+   * @tparam Services a list of service types
+   * @return a lar::ProviderPack with providers from all specified services
+   * @throws art::Exception as lar::providerFrom()
+   * @see lar::providersFrom(), lar::cachedProviderFrom()
+   *
+   * The result is the same as `lar::providersFrom()`, but the providers are
+   * obtained via `lar::cachedProviderFrom()`.
+   */
+  template <typename... Services>
+  auto cachedProvidersFrom()
+    { return lar::makeProviderPack(lar::cachedProviderFrom<Services>()...); }
+
+
+  /**
+   * @brief Makes all the providers cached on any thread obsolete.
+   * @see lar::cachedProviderFrom()
+   *
+   * The next call of `lar::cachedProviderFrom()` on each thread asks again
+   * the provider to the service.
+   * Services should call this function whenever they replace their provider
+   * or its content changes (e.g. a new geometry is loaded).
+   */
+  inline void invalidateCachedProviders()
+    { details::ProviderCacheEpoch.fetch_add(1U, std::memory_order_acq_rel); }
+
+
 
   //----------------------------------------------------------------------------
   namespace details {
@@ -10,6 +10,9 @@
 #define GEO_AUXDETGEOMETRY_H
 
 // LArSoft libraries
+#include "larcore/Geometry/GeometryLoadProfiler.h"
+#include "larcore/Geometry/AuxDetSpatialIndex.h"
+#include "larcore/Geometry/AuxDetGeometrySnapshot.h"
 
 // the following are included for convenience only
 #include "larcorealg/Geometry/AuxDetGeometryCore.h"
@@ -29,7 +32,10 @@
 #include <set>
 #include <cstring>
 #include <memory>
+#include <atomic>
+#include <mutex>
 #include <iterator> // std::forward_iterator_tag
+#include <cstdint> // std::uint64_t
 
 
 namespace geo {
@@ -57,6 +63,12 @@ namespace geo {
    * - *RelativePath* (string, default: no path): this path is prepended to the
    *   geometry file names before searching from them; the path string does not
    *   affect the file name
+   * - *ResolvedPathManifest* (string, default: empty): if not empty, path of a
+   *   file where the locations of the geometry files found in `FW_SEARCH_PATH`
+   *   are recorded, and read back by the following jobs to avoid searching
+   *   again (see geo::GeometryFileLocator); the file is shared by `Geometry`
+   *   and `AuxDetGeometry`, and searches are remembered within the process
+   *   even without a manifest
    * - *GDML* (string, mandatory): path of the GDML file to be served to Geant4
    *   for detector simulation. The full file is composed out of the optional
    *   relative path specified by `RelativePath` path and the base name
@@ -84,10 +96,53 @@ namespace geo {
    *   is directly passed to the channel mapping algorithm (see
    *   geo::ChannelMapAlg); its content is dependent on the chosen
    *   implementation of ChannelMapAlg
+   * - *LazyLoading* (boolean, default: false): if true, on construction the
+   *   geometry files are only located, and the geometry is actually loaded
+   *   on the first request of the service provider via `GetProvider()` or
+   *   `GetProviderPtr()`; the loading is thread-safe
+   * - *ProfileLoading* (boolean, default: false): if true, the time spent in
+   *   each step of the geometry loading and the peak memory usage after it
+   *   are reported via message facility (category `AuxDetGeometryProfile`),
+   *   together with a summary table at the end of the job
+   *   (see geo::GeometryLoadProfiler)
+   * - *UseSpatialIndex* (boolean, default: false): if true,
+   *   `FindAuxDetAtPosition()` uses a spatial index of the auxiliary detectors
+   *   (see geo::AuxDetSpatialIndex), which gives the same answers as the
+   *   default `geo::AuxDetChannelMapAlg::NearestAuxDet()`; it must be enabled
+   *   only if the channel mapping of the experiment does not redefine that
+   *   function, since otherwise the two may disagree; if false, the queries
+   *   are answered by the channel mapping
+   * - *SpatialIndexTolerance* (real, default: 0): largest tolerance [cm]
+   *   supported by the spatial index of the auxiliary detectors;
+   *   queries with larger tolerance are slower
    *
    * @note Currently, the file defined by `GDML` parameter is also served to
    * ROOT for the internal geometry representation.
    *
+   *
+   * Geometry reloading
+   * -------------------
+   *
+   * As in `geo::Geometry`, the information derived from each loaded geometry
+   * is collected into an immutable `geo::AuxDetGeometrySnapshot`, which is
+   * built aside and then published by atomically replacing the previous one
+   * (`Snapshot()`); each snapshot is tagged by a generation number
+   * (`Generation()`). Loading of geometries is serialized, and all the query
+   * functions of this service are `const` and do not modify any state,
+   * besides the one-time lazy loading.
+   *
+   * The geometry description (`geo::AuxDetGeometryCore`) is updated in place,
+   * since ROOT supports a single geometry per process; this happens only on
+   * `sPreBeginRun`, when art has no event in flight on any schedule, so it is
+   * safe to use this service with multiple schedules as long as geometry
+   * information is not cached across runs.
+   *
+   * The ROOT geometry is shared with `geo::Geometry`: it is imported only if
+   * it has not been already loaded from the same file by any of the two
+   * services. When the other service imports a different file (e.g. for a
+   * new detector), this service loads its geometry again at the beginning
+   * of the run (see `geo::GeometrySourceRegistry`).
+   *
    */
   class AuxDetGeometry
   {
@@ -96,21 +151,95 @@ namespace geo {
     AuxDetGeometry(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
 
     /// Returns a constant reference to the service provider
-    AuxDetGeometryCore const& GetProvider() const { return fProvider; }
+    AuxDetGeometryCore const& GetProvider() const
+      { EnsureLoaded(); return fProvider; }
 
     /// Returns a constant pointer to the service provider
     AuxDetGeometryCore const* GetProviderPtr() const { return &GetProvider(); }
 
+    /**
+     * @brief Returns the information precomputed for the current geometry.
+     * @return a shared pointer to the current snapshot (never `nullptr`)
+     *
+     * The returned snapshot stays valid for as long as the pointer is kept,
+     * even after a new geometry is loaded.
+     * This function is thread-safe.
+     */
+    std::shared_ptr<geo::AuxDetGeometrySnapshot const> Snapshot() const
+      { EnsureLoaded(); return std::atomic_load(&fSnapshot); }
+
+    /**
+     * @brief Returns the generation number of the current geometry.
+     * @see `geo::Geometry::Generation()`
+     */
+    std::uint64_t Generation() const
+      { EnsureLoaded(); return fGeneration.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Returns the index of the auxiliary detector containing `point`.
+     * @param point the point to be located [cm]
+     * @param tolerance how far from the detector borders is still inside [cm]
+     * @return the index of the detector,
+     *         `geo::AuxDetSpatialIndex::InvalidIndex` if none contains `point`
+     * @see `geo::AuxDetGeometryCore::FindAuxDetAtPosition()`
+     *
+     * Differently from the provider method, a point out of all the detectors
+     * does not cause an exception. If `UseSpatialIndex` is set, the search
+     * uses the spatial index of the current `Snapshot()` (loops on many points
+     * should rather get the snapshot once and query its index directly);
+     * otherwise, the provider is queried.
+     */
+    std::size_t FindAuxDetAtPosition
+      (geo::Point_t const& point, double tolerance = 0.0) const
+      {
+        if (!fUseSpatialIndex)
+          return FindAuxDetWithChannelMap(point, tolerance);
+        auto const snapshot = Snapshot();
+        return snapshot->SpatialIndex()
+          .FindAuxDetAtPosition(fProvider, point, tolerance);
+      }
+
   private:
 
     /// Updates the geometry if needed at the beginning of each new run
     void preBeginRun(art::Run const& run);
 
+    /// Loads the geometry of the detector of `run`; returns if it did.
+    bool LoadRunGeometry(art::Run const& run);
+
+    /// Rebuilds the geometry if another service replaced its ROOT geometry.
+    void ReloadIfStale();
+
+    /// Reports the loading profile summary at the end of the job.
+    void postEndJob();
+
+    /// Full paths of the files describing a geometry.
+    struct GeometryFiles_t {
+      std::string GDMLfile; ///< File for Geant4.
+      std::string ROOTfile; ///< File for ROOT geometry.
+    }; // GeometryFiles_t
+
     /// Expands the provided paths and loads the geometry description(s)
     void LoadNewGeometry(std::string gdmlfile, std::string rootfile);
 
+    /// Expands the provided path and finds the geometry files.
+    GeometryFiles_t LocateGeometryFiles(std::string const& gdmlfile) const;
+
+    /// Loads the geometry description from the specified files.
+    void LoadGeometryFiles(GeometryFiles_t const& files);
+
+    /// Loads the pending geometry, if any (thread-safe).
+    void EnsureLoaded() const;
+
     void InitializeChannelMap();
 
+    /// Locates `point` via the channel mapping (`InvalidIndex` if nowhere).
+    std::size_t FindAuxDetWithChannelMap
+      (geo::Point_t const& point, double tolerance) const;
+
+    /// Computes the information on the current geometry.
+    std::shared_ptr<geo::AuxDetGeometrySnapshot const> MakeSnapshot() const;
+
     /// Returns a reference to the service provider
     AuxDetGeometryCore& GetProvider() { return fProvider; }
 
@@ -125,6 +254,25 @@ namespace geo {
     bool                      fForceUseFCLOnly;  ///< Force Geometry to only use the geometry
                                                  ///< files specified in the fcl file
     fhicl::ParameterSet       fSortingParameters;///< Parameter set to define the channel map sorting
+
+    bool                      fLazyLoading; ///< Whether to defer geometry loading.
+    bool                      fUseSpatialIndex; ///< Whether to locate points via index.
+    double                    fSpatialIndexTolerance; ///< Largest indexed tolerance.
+
+    /// Information precomputed for the current geometry (atomic access only).
+    std::shared_ptr<geo::AuxDetGeometrySnapshot const> fSnapshot;
+
+    /// Number of geometries loaded so far.
+    std::atomic<std::uint64_t> fGeneration { 0U };
+
+    GeometryFiles_t           fCurrentGeometry; ///< Files of the loaded geometry.
+
+    /// Geometry waiting to be loaded in lazy mode.
+    GeometryFiles_t           fPendingGeometry;
+    mutable std::atomic<bool> fLoaded { false }; ///< Whether pending geometry is loaded.
+    mutable std::mutex        fLoadMutex; ///< Serializes the loading.
+
+    geo::GeometryLoadProfiler fProfiler; ///< Statistics of the loading steps.
   };
 
 } // namespace geo
@@ -0,0 +1,85 @@
+/**
+ * @file   larcore/Geometry/AuxDetGeometrySnapshot.h
+ * @brief  Immutable set of precomputed information about auxiliary detectors.
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARCORE_GEOMETRY_AUXDETGEOMETRYSNAPSHOT_H
+#define LARCORE_GEOMETRY_AUXDETGEOMETRYSNAPSHOT_H
+
+// LArSoft libraries
+#include "larcore/Geometry/AuxDetSpatialIndex.h"
+
+// C/C++ standard libraries
+#include <memory> // std::unique_ptr<>
+#include <string>
+#include <utility> // std::move()
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  /**
+   * @brief Information precomputed by `geo::AuxDetGeometry` for a geometry.
+   *
+   * This is the equivalent of `geo::GeometrySnapshot` for the auxiliary
+   * detectors: it is created once for each loaded geometry, never modified
+   * afterwards, and published by atomically replacing the previous one
+   * (see `geo::AuxDetGeometry::Snapshot()`).
+   *
+   * @note Snapshots may outlive the geometry description they were computed
+   *       from: their content must never refer to objects of
+   *       `geo::AuxDetGeometryCore` (like `geo::AuxDetGeo`).
+   */
+  class AuxDetGeometrySnapshot {
+
+      public:
+
+    /// Content of the snapshot.
+    struct Data_t {
+
+      /// Name of the detector the snapshot describes.
+      std::string detectorName;
+
+      /// Number of auxiliary detectors.
+      std::size_t nAuxDets = 0U;
+
+      /// Spatial index of the auxiliary detectors.
+      std::unique_ptr<geo::AuxDetSpatialIndex const> spatialIndex
+        = std::make_unique<geo::AuxDetSpatialIndex const>();
+
+    }; // Data_t
+
+
+    /// Constructor: an empty snapshot.
+    AuxDetGeometrySnapshot() = default;
+
+    /// Constructor: takes ownership of the specified content.
+    explicit AuxDetGeometrySnapshot(Data_t data): fData(std::move(data)) {}
+
+    // no copy, no move: the snapshot is shared via pointers
+    AuxDetGeometrySnapshot(AuxDetGeometrySnapshot const&) = delete;
+    AuxDetGeometrySnapshot& operator= (AuxDetGeometrySnapshot const&) = delete;
+
+    /// Returns the name of the detector the snapshot describes.
+    std::string const& DetectorName() const { return fData.detectorName; }
+
+    /// Returns the number of auxiliary detectors.
+    std::size_t NAuxDets() const { return fData.nAuxDets; }
+
+    /// Returns the spatial index of the auxiliary detectors.
+    geo::AuxDetSpatialIndex const& SpatialIndex() const
+      { return *fData.spatialIndex; }
+
+
+      private:
+
+    Data_t fData; ///< Content of the snapshot.
+
+  }; // class AuxDetGeometrySnapshot
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_AUXDETGEOMETRYSNAPSHOT_H
@@ -8,16 +8,19 @@
 // class header
 #include "larcore/Geometry/AuxDetGeometry.h"
 #include "larcore/Geometry/AuxDetExptGeoHelperInterface.h"
+#include "larcore/Geometry/GeometrySourceRegistry.h"
+#include "larcore/Geometry/GeometryFileLocator.h"
+#include "larcore/CoreUtils/ServiceUtil.h" // lar::invalidateCachedProviders()
 
 // lar includes
 #include "larcoreobj/SummaryData/RunData.h"
 
 // Framework includes
 #include "cetlib_except/exception.h"
-#include "cetlib/search_path.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
 // C/C++ standard libraries
+#include <sstream>
 #include <string>
 
 
@@ -31,12 +34,29 @@ namespace geo {
     , fRelPath          (pset.get< std::string       >("RelativePath",      ""   ))
     , fForceUseFCLOnly  (pset.get< bool              >("ForceUseFCLOnly" ,  false))
     , fSortingParameters(pset.get<fhicl::ParameterSet>("SortingParameters", {}))
+    , fLazyLoading      (pset.get< bool              >("LazyLoading",       false))
+    , fUseSpatialIndex  (pset.get< bool              >("UseSpatialIndex",   false))
+    , fSpatialIndexTolerance(pset.get<double>("SpatialIndexTolerance", 0.0))
+    , fSnapshot(std::make_shared<geo::AuxDetGeometrySnapshot const>())
+    , fProfiler("AuxDetGeometryProfile", pset.get<bool>("ProfileLoading", false))
   {
     // add a final directory separator ("/") to fRelPath if not already there
     if (!fRelPath.empty() && (fRelPath.back() != '/')) fRelPath += '/';
 
+    std::string const manifestPath
+      = pset.get<std::string>("ResolvedPathManifest", "");
+    if (!manifestPath.empty())
+      geo::GeometryFileLocator::Instance().UseManifest(manifestPath);
+
+    mf::LogInfo("AuxDetGeometry") << "Points are located in the auxiliary"
+      " detectors by " << (fUseSpatialIndex
+        ? "a spatial index (same answers as the default channel mapping)"
+        : "the channel mapping");
+
     // register a callback to be executed when a new run starts
     reg.sPreBeginRun.watch(this, &AuxDetGeometry::preBeginRun);
+    if (fProfiler.enabled())
+      reg.sPostEndJob.watch(this, &AuxDetGeometry::postEndJob);
 
     //......................................................................
     // 5.15.12 BJR: use the gdml file for both the fGDMLFile and fROOTFile
@@ -47,7 +67,7 @@ namespace geo {
     std::string GDMLFileName = pset.get<std::string>("GDML");
     std::string ROOTFileName = pset.get<std::string>("GDML");
 
-    // load the geometry
+    // load the geometry (in lazy mode, just locate it)
     LoadNewGeometry(GDMLFileName, ROOTFileName);
 
   } // Geometry::Geometry()
@@ -55,11 +75,20 @@ namespace geo {
 
   void AuxDetGeometry::preBeginRun(art::Run const& run)
   {
-    // FIXME this seems utterly wrong: constructor loads geometry based on an
-    // explicit parameter, whereas here we load it by detector name
+    // if the detector has not changed, the geometry may still need a rebuild
+    // because of a new ROOT geometry imported by another service
+    if (!LoadRunGeometry(run)) ReloadIfStale();
+  } // AuxDetGeometry::preBeginRun()
+
+
+  //......................................................................
+  bool AuxDetGeometry::LoadRunGeometry(art::Run const& run)
+  {
+    // as in geo::Geometry, the geometry of a new detector is loaded from
+    // the file named after it, rather than from the configured one
 
     // if we are requested to stick to the configured geometry, do nothing
-    if (fForceUseFCLOnly) return;
+    if (fForceUseFCLOnly) return false;
 
     // check here to see if we need to load a new geometry.
     // get the detector id from the run object
@@ -69,23 +98,57 @@ namespace geo {
       mf::LogWarning("LoadNewGeometry") << "cannot find sumdata::RunData object to grab detector name\n"
                                         << "this is expected if generating MC files\n"
                                         << "using default geometry from configuration file\n";
-      return;
+      return false;
     }
 
     // if the detector name is still the same, everything is fine
     std::string newDetectorName = rdcol.front()->DetName();
-    if (GetProvider().DetectorName() == newDetectorName) return;
+    if (fProvider.DetectorName() == newDetectorName) return false;
 
-    // else {
-    //   // the detector name is specified in the RunData object
-    //   SetDetectorName(newDetectorName);
-    // }
+    // the detector name is specified in the RunData object
+    GetProvider().SetDetectorName(newDetectorName);
 
-    LoadNewGeometry(
-      GetProvider().DetectorName() + ".gdml",
-      GetProvider().DetectorName() + ".gdml"
-      );
-  } // Geometry::preBeginRun()
+    LoadNewGeometry(newDetectorName + ".gdml", newDetectorName + ".gdml");
+    return true;
+  } // AuxDetGeometry::LoadRunGeometry()
+
+
+  //......................................................................
+  void AuxDetGeometry::ReloadIfStale()
+  {
+    auto const& registry = geo::GeometrySourceRegistry::Instance();
+    if (!registry.IsStale("AuxDetGeometry")) return;
+
+    std::lock_guard<std::mutex> const lock{ fLoadMutex };
+
+    // a pending lazy loading will find the new ROOT geometry by itself
+    if (fLazyLoading && !fLoaded.load(std::memory_order_relaxed)) return;
+
+    // importing our file again would make the other service stale in turn
+    GeometryFiles_t const files = fCurrentGeometry;
+    if (registry.CurrentSource() != files.ROOTfile) {
+      throw cet::exception("AuxDetGeometry")
+        << "The ROOT geometry was replaced with the one from '"
+        << registry.CurrentSource() << "', while this service is configured"
+        " to use '" << files.ROOTfile << "'; ROOT supports a single geometry"
+        " per process, so all the services must use the same file.\n";
+    }
+    mf::LogInfo("AuxDetGeometry") << "Rebuilding the geometry of '"
+      << fProvider.DetectorName()
+      << "' on the ROOT geometry loaded by another service";
+    LoadGeometryFiles(files);
+  } // AuxDetGeometry::ReloadIfStale()
+
+
+  //......................................................................
+  void AuxDetGeometry::postEndJob()
+  {
+    std::ostringstream summary;
+    fProfiler.PrintSummary(summary, "  ");
+    mf::LogInfo("AuxDetGeometryProfile")
+      << "Auxiliary detector geometry loading profile summary:\n"
+      << summary.str();
+  } // AuxDetGeometry::postEndJob()
 
 
   //......................................................................
@@ -93,15 +156,58 @@ namespace geo {
   {
     // the channel map is responsible of calling the channel map configuration
     // of the geometry
-    auto channelMap = art::ServiceHandle<geo::AuxDetExptGeoHelperInterface>()->ConfigureAuxDetChannelMapAlg(fSortingParameters);
+    auto configTimer = fProfiler.Step("channel mapping configuration");
+    art::ServiceHandle<geo::AuxDetExptGeoHelperInterface const> helper{};
+    auto channelMap = helper->ConfigureAuxDetChannelMapAlg(fSortingParameters);
     if (!channelMap) {
       throw cet::exception("ChannelMapLoadFail") << " failed to load new channel map";
     }
+    configTimer.stop();
+
+    auto applyTimer = fProfiler.Step("channel mapping application");
     fProvider.ApplyChannelMap(move(channelMap));
   } // Geometry::InitializeChannelMap()
 
   //......................................................................
   void AuxDetGeometry::LoadNewGeometry(std::string gdmlfile, std::string /* rootfile */)
+  {
+    auto searchTimer = fProfiler.Step("files search");
+    GeometryFiles_t files = LocateGeometryFiles(gdmlfile);
+    searchTimer.stop();
+
+    // loadings are serialized, also with the lazy one
+    std::lock_guard<std::mutex> const lock{ fLoadMutex };
+
+    // in lazy mode, if the geometry has not been used yet, just take note
+    if (fLazyLoading && !fLoaded.load(std::memory_order_relaxed)) {
+      fPendingGeometry = std::move(files);
+      return;
+    }
+
+    LoadGeometryFiles(files);
+    fLoaded.store(true, std::memory_order_release);
+
+  } // Geometry::LoadNewGeometry()
+
+  //......................................................................
+  void AuxDetGeometry::EnsureLoaded() const
+  {
+    if (fLoaded.load(std::memory_order_acquire)) return;
+
+    std::lock_guard<std::mutex> const lock{ fLoadMutex };
+    if (fLoaded.load(std::memory_order_relaxed)) return; // loaded meanwhile
+
+    // the service provider is conceptually unchanged by its initialization
+    auto& self = const_cast<AuxDetGeometry&>(*this);
+    self.LoadGeometryFiles(fPendingGeometry);
+    self.fPendingGeometry = {};
+    fLoaded.store(true, std::memory_order_release);
+
+  } // AuxDetGeometry::EnsureLoaded()
+
+  //......................................................................
+  AuxDetGeometry::GeometryFiles_t AuxDetGeometry::LocateGeometryFiles
+    (std::string const& gdmlfile) const
   {
     // start with the relative path
     std::string GDMLFileName(fRelPath), ROOTFileName(fRelPath);
@@ -111,32 +217,83 @@ namespace geo {
     GDMLFileName.append(gdmlfile);
 
     // Search all reasonable locations for the GDML file that contains
-    // the detector geometry.
-    // cet::search_path constructor decides if initialized value is a path
-    // or an environment variable
-    cet::search_path sp("FW_SEARCH_PATH");
+    // the detector geometry; the search results are shared within the
+    // process, and GDML and ROOT files, usually the same, are searched once
+    geo::GeometryFileLocator& locator = geo::GeometryFileLocator::Instance();
 
-    std::string GDMLfile;
-    if( !sp.find_file(GDMLFileName, GDMLfile) ) {
+    GeometryFiles_t files;
+    if( !locator.FindFile(GDMLFileName, files.GDMLfile) ) {
       throw cet::exception("AuxDetGeometry") << "cannot find the gdml geometry file:"
                                              << "\n" << GDMLFileName
                                              << "\nbail ungracefully.\n";
     }
 
-    std::string ROOTfile;
-    if( !sp.find_file(ROOTFileName, ROOTfile) ) {
+    if( !locator.FindFile(ROOTFileName, files.ROOTfile) ) {
       throw cet::exception("AuxDetGeometry") << "cannot find the root geometry file:\n"
                                              << "\n" << ROOTFileName
                                              << "\nbail ungracefully.\n";
     }
 
+    return files;
+  } // AuxDetGeometry::LocateGeometryFiles()
+
+  //......................................................................
+  void AuxDetGeometry::LoadGeometryFiles(GeometryFiles_t const& files)
+  {
+    auto timer = fProfiler.Step("total loading");
+
     // initialize the geometry with the files we have found
-    GetProvider().LoadGeometryFile(GDMLfile, ROOTfile);
+    {
+      auto loadTimer = fProfiler.Step("geometry description");
+      // the ROOT geometry is shared with the other services when possible
+      geo::GeometrySourceRegistry::Instance().UseSource(
+        "AuxDetGeometry", files.ROOTfile,
+        [&](bool import){
+          GetProvider().LoadGeometryFile
+            (files.GDMLfile, files.ROOTfile, import);
+        });
+    }
+
+    fCurrentGeometry = files;
 
     // now update the channel map
     InitializeChannelMap();
 
-  } // Geometry::LoadNewGeometry()
+    // the new information replaces the old one in a single step;
+    // users still holding the old snapshot keep it alive
+    std::atomic_store(&fSnapshot, MakeSnapshot());
+    fGeneration.fetch_add(1U, std::memory_order_acq_rel);
+    lar::invalidateCachedProviders();
+
+  } // AuxDetGeometry::LoadGeometryFiles()
+
+  //......................................................................
+  std::shared_ptr<geo::AuxDetGeometrySnapshot const>
+  AuxDetGeometry::MakeSnapshot() const
+  {
+    auto timer = fProfiler.Step("precomputed information");
+    geo::AuxDetGeometrySnapshot::Data_t data;
+    data.detectorName = fProvider.DetectorName();
+    data.nAuxDets = fProvider.NAuxDets();
+    if (fUseSpatialIndex) {
+      data.spatialIndex = std::make_unique<geo::AuxDetSpatialIndex const>
+        (fProvider, fSpatialIndexTolerance);
+    }
+    return std::make_shared<geo::AuxDetGeometrySnapshot const>(std::move(data));
+  } // AuxDetGeometry::MakeSnapshot()
+
+  //......................................................................
+  std::size_t AuxDetGeometry::FindAuxDetWithChannelMap
+    (geo::Point_t const& point, double tolerance) const
+  {
+    // the channel mapping throws when no detector contains the point
+    try {
+      return GetProvider().FindAuxDetAtPosition(point, tolerance);
+    }
+    catch (cet::exception const&) {
+      return geo::AuxDetSpatialIndex::InvalidIndex;
+    }
+  } // AuxDetGeometry::FindAuxDetWithChannelMap()
 
   DEFINE_ART_SERVICE(AuxDetGeometry)
 } // namespace geo
@@ -0,0 +1,103 @@
+/**
+ * @file   larcore/Geometry/AuxDetSpatialIndex.cc
+ * @brief  Spatial index for the location of points in auxiliary detectors.
+ * @see    larcore/Geometry/AuxDetSpatialIndex.h
+ */
+
+// library header
+#include "larcore/Geometry/AuxDetSpatialIndex.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/AuxDetGeometryCore.h"
+#include "larcorealg/Geometry/AuxDetGeo.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::min(), std::max()
+#include <cmath> // std::abs()
+
+
+//------------------------------------------------------------------------------
+geo::AuxDetSpatialIndex::AuxDetSpatialIndex
+  (geo::AuxDetGeometryCore const& geom, double maxTolerance)
+  : fMaxTolerance(maxTolerance)
+{
+  std::size_t const nAuxDets = geom.NAuxDets();
+
+  std::vector<geo::UniformGridIndex::Box_t> boxes;
+  boxes.reserve(nAuxDets);
+  for (std::size_t iDet = 0; iDet < nAuxDets; ++iDet) {
+    geo::AuxDetGeo const& auxDet = geom.AuxDet(iDet);
+
+    // world bounding box of the local box enclosing the trapezoid
+    double const halfSize[3] = {
+      std::max(auxDet.HalfWidth1(), auxDet.HalfWidth2()) + fMaxTolerance,
+      auxDet.HalfHeight() + fMaxTolerance,
+      0.5 * auxDet.Length() + fMaxTolerance
+    };
+    geo::UniformGridIndex::Box_t box;
+    for (unsigned int corner = 0; corner < 8U; ++corner) {
+      geo::AuxDetGeo::LocalPoint_t const local {
+        ((corner & 1U)? halfSize[0]: -halfSize[0]),
+        ((corner & 2U)? halfSize[1]: -halfSize[1]),
+        ((corner & 4U)? halfSize[2]: -halfSize[2])
+      };
+      geo::Point_t const world = auxDet.toWorldCoords(local);
+      double const coords[3] = { world.X(), world.Y(), world.Z() };
+      for (unsigned int axis = 0; axis < 3U; ++axis) {
+        box.min[axis] = (corner == 0U)
+          ? coords[axis]: std::min(box.min[axis], coords[axis]);
+        box.max[axis] = (corner == 0U)
+          ? coords[axis]: std::max(box.max[axis], coords[axis]);
+      } // for axes
+    } // for corners
+    boxes.push_back(box);
+  } // for auxiliary detectors
+
+  fGrid = geo::UniformGridIndex{ boxes };
+
+} // geo::AuxDetSpatialIndex::AuxDetSpatialIndex()
+
+
+//------------------------------------------------------------------------------
+std::size_t geo::AuxDetSpatialIndex::FindAuxDetAtPosition(
+  geo::AuxDetGeometryCore const& geom,
+  geo::Point_t const& point, double tolerance /* = 0.0 */
+) const {
+
+  if (tolerance > fMaxTolerance) { // not supported by the grid: test all
+    std::size_t const nAuxDets = geom.NAuxDets();
+    for (std::size_t iDet = 0; iDet < nAuxDets; ++iDet)
+      if (contains(geom.AuxDet(iDet), point, tolerance)) return iDet;
+    return InvalidIndex;
+  }
+
+  for (std::size_t iDet: fGrid.Candidates(point.X(), point.Y(), point.Z()))
+    if (contains(geom.AuxDet(iDet), point, tolerance)) return iDet;
+  return InvalidIndex;
+
+} // geo::AuxDetSpatialIndex::FindAuxDetAtPosition()
+
+
+//------------------------------------------------------------------------------
+bool geo::AuxDetSpatialIndex::contains
+  (geo::AuxDetGeo const& auxDet, geo::Point_t const& point, double tolerance)
+{
+  // same test as in the default geo::AuxDetChannelMapAlg::NearestAuxDet()
+  auto const local = auxDet.toLocalCoords(point);
+
+  double const halfLength = 0.5 * auxDet.Length();
+  if (std::abs(local.Z()) > halfLength + tolerance) return false;
+  if (std::abs(local.Y()) > auxDet.HalfHeight() + tolerance) return false;
+
+  // the width changes linearly along the length (trapezoid)
+  double const halfCenterWidth
+    = 0.5 * (auxDet.HalfWidth1() + auxDet.HalfWidth2());
+  double const halfWidth = halfCenterWidth
+    - local.Z() * (halfCenterWidth - auxDet.HalfWidth2()) / halfLength;
+  return std::abs(local.X()) <= halfWidth + tolerance;
+
+} // geo::AuxDetSpatialIndex::contains()
+
+
+//------------------------------------------------------------------------------
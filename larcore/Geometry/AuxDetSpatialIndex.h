@@ -0,0 +1,98 @@
+/**
+ * @file   larcore/Geometry/AuxDetSpatialIndex.h
+ * @brief  Spatial index for the location of points in auxiliary detectors.
+ * @see    larcore/Geometry/AuxDetSpatialIndex.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_AUXDETSPATIALINDEX_H
+#define LARCORE_GEOMETRY_AUXDETSPATIALINDEX_H
+
+// LArSoft libraries
+#include "larcore/Geometry/UniformGridIndex.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <limits>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  class AuxDetGeometryCore;
+  class AuxDetGeo;
+
+  /**
+   * @brief Finds the auxiliary detector containing a point, via spatial index.
+   *
+   * `geo::AuxDetGeometryCore::FindAuxDetAtPosition()` tests all the
+   * auxiliary detectors one by one, and throws an exception when none
+   * contains the point.
+   * This object places the bounding boxes of the auxiliary detectors in a
+   * uniform grid (`geo::UniformGridIndex`), so that only the few detectors
+   * near the point need to be tested, and reports a point out of all
+   * detectors with a special return value (`InvalidIndex`).
+   *
+   * The final test on each candidate detector is the same (trapezoidal shape
+   * in the local frame of the detector, with a tolerance) and in the same
+   * order as in the default `geo::AuxDetChannelMapAlg::NearestAuxDet()`,
+   * so that the answers are the same as with that algorithm. Channel mapping
+   * algorithms redefining `NearestAuxDet()` may give different answers: for
+   * them, `geo::AuxDetGeometry` does not use this index
+   * (see its `UseSpatialIndex` parameter). The grid is built including the largest tolerance that can be used
+   * in the queries (`MaxTolerance()`); queries with a larger tolerance fall
+   * back to testing all the detectors.
+   *
+   * The index stores only detector indices, so the queries require the
+   * geometry itself.
+   */
+  class AuxDetSpatialIndex {
+
+      public:
+
+    /// Value returned when no auxiliary detector contains a point.
+    static constexpr std::size_t InvalidIndex
+      = std::numeric_limits<std::size_t>::max();
+
+    /// Constructor: an empty index.
+    AuxDetSpatialIndex() = default;
+
+    /**
+     * @brief Constructor: indexes all the auxiliary detectors of `geom`.
+     * @param geom the auxiliary detector geometry to be indexed
+     * @param maxTolerance largest tolerance to be supported [cm]
+     */
+    AuxDetSpatialIndex(geo::AuxDetGeometryCore const& geom, double maxTolerance);
+
+    /// Returns the largest tolerance supported by the index [cm].
+    double MaxTolerance() const { return fMaxTolerance; }
+
+    /**
+     * @brief Returns the index of the auxiliary detector containing `point`.
+     * @param geom the geometry the index was built from
+     * @param point the point to be located [cm]
+     * @param tolerance how far from the detector borders is still inside [cm]
+     * @return the index of the detector, `InvalidIndex` if none contains it
+     * @see geo::AuxDetGeometryCore::FindAuxDetAtPosition()
+     */
+    std::size_t FindAuxDetAtPosition(
+      geo::AuxDetGeometryCore const& geom,
+      geo::Point_t const& point, double tolerance = 0.0
+      ) const;
+
+
+      private:
+
+    double fMaxTolerance = 0.0; ///< Largest supported tolerance.
+
+    geo::UniformGridIndex fGrid; ///< Grid of auxiliary detector boxes.
+
+    /// Returns whether `point` belongs to `auxDet` within `tolerance`.
+    static bool contains
+      (geo::AuxDetGeo const& auxDet, geo::Point_t const& point, double tolerance);
+
+  }; // class AuxDetSpatialIndex
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_AUXDETSPATIALINDEX_H
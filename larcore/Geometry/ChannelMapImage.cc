@@ -0,0 +1,276 @@
+/**
+ * @file   larcore/Geometry/ChannelMapImage.cc
+ * @brief  Channel mapping tables shared among processes via memory mapping.
+ * @see    larcore/Geometry/ChannelMapImage.h
+ */
+
+// library header
+#include "larcore/Geometry/ChannelMapImage.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <fstream>
+#include <algorithm> // std::copy_n(), std::equal()
+#include <iterator> // std::begin(), std::end()
+#include <utility> // std::move()
+#include <cstring> // std::memcpy(), std::strncmp()
+#include <cstdint> // std::uint32_t, std::uint64_t
+#include <cstdio> // std::rename(), std::remove()
+#include <fcntl.h> // open()
+#include <sys/mman.h> // mmap(), munmap()
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // close(), getpid()
+
+
+namespace {
+
+  /// Signature at the beginning of each image file.
+  constexpr char ImageMagic[8] = { 'L', 'A', 'R', 'C', 'H', 'M', 'A', 'P' };
+
+  /// Version of the image format.
+  constexpr std::uint32_t ImageVersion = 1U;
+
+  /// Header of a channel mapping image file.
+  struct ImageHeader_t {
+    char magic[8];               ///< Always `ImageMagic`.
+    std::uint32_t version;       ///< Version of the format.
+    std::uint32_t offsetSize;    ///< Size of each channel wire offset.
+    std::uint32_t wireIDsize;    ///< Size of each wire ID.
+    std::uint32_t channelSize;   ///< Size of each channel ID.
+    std::uint64_t nChannels;     ///< Number of channels.
+    std::uint64_t nChannelWires; ///< Number of entries in the wire list.
+    std::uint64_t nWires;        ///< Number of wires.
+    std::uint64_t offsetsStart;  ///< Position of the channel wire offsets.
+    std::uint64_t wiresStart;    ///< Position of the wire list.
+    std::uint64_t channelsStart; ///< Position of the wire channels.
+    std::uint64_t totalSize;     ///< Size of the whole image.
+    char key[64];                ///< Geometry key (null-terminated).
+  }; // ImageHeader_t
+
+  /// Returns `n` rounded up to a multiple of 8.
+  constexpr std::uint64_t aligned(std::uint64_t n) { return (n + 7) / 8 * 8; }
+
+
+  /// Owner of a memory mapping.
+  class MemoryMap_t {
+    void* fAddress;
+    std::size_t fSize;
+      public:
+    MemoryMap_t(void* address, std::size_t size)
+      : fAddress(address), fSize(size) {}
+    MemoryMap_t(MemoryMap_t const&) = delete;
+    MemoryMap_t& operator= (MemoryMap_t const&) = delete;
+    ~MemoryMap_t() { ::munmap(fAddress, fSize); }
+    char const* data() const { return static_cast<char const*>(fAddress); }
+    std::size_t size() const { return fSize; }
+  }; // MemoryMap_t
+
+
+  /// Returns a header with the data layout of this process and `key`.
+  ImageHeader_t layoutHeader(std::string const& key) {
+    ImageHeader_t header {};
+    std::copy_n(ImageMagic, sizeof(ImageMagic), header.magic);
+    header.version = ImageVersion;
+    header.offsetSize = sizeof(std::size_t);
+    header.wireIDsize = sizeof(geo::WireID);
+    header.channelSize = sizeof(raw::ChannelID_t);
+    key.copy(header.key, sizeof(header.key) - 1);
+    return header;
+  } // layoutHeader()
+
+
+  /// Returns the header for the specified table and key.
+  ImageHeader_t makeHeader
+    (geo::ChannelMapTable::RawData_t const& data, std::string const& key)
+  {
+    ImageHeader_t header = layoutHeader(key);
+    header.nChannels = data.nChannels;
+    header.nChannelWires = data.channelWireOffsets[data.nChannels];
+    header.nWires = data.nWires;
+    header.offsetsStart = aligned(sizeof(ImageHeader_t));
+    header.wiresStart = aligned
+      (header.offsetsStart + (header.nChannels + 1) * header.offsetSize);
+    header.channelsStart = aligned
+      (header.wiresStart + header.nChannelWires * header.wireIDsize);
+    header.totalSize = aligned
+      (header.channelsStart + header.nWires * header.channelSize);
+    return header;
+  } // makeHeader()
+
+
+  /// Returns whether `header` is compatible with this process and `key`.
+  bool isCompatible(ImageHeader_t const& header, std::string const& key) {
+    ImageHeader_t const expected = layoutHeader(key);
+    return std::equal
+        (std::begin(ImageMagic), std::end(ImageMagic), header.magic)
+      && (header.version == expected.version)
+      && (header.offsetSize == expected.offsetSize)
+      && (header.wireIDsize == expected.wireIDsize)
+      && (header.channelSize == expected.channelSize)
+      && (std::strncmp(header.key, expected.key, sizeof(header.key)) == 0)
+      ;
+  } // isCompatible()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+geo::ChannelMapImage::ChannelMapImage(std::string directory)
+  : fDirectory(std::move(directory))
+{
+  // add a final directory separator ("/") if not already there
+  if (!fDirectory.empty() && (fDirectory.back() != '/')) fDirectory += '/';
+} // geo::ChannelMapImage::ChannelMapImage()
+
+
+//------------------------------------------------------------------------------
+std::string geo::ChannelMapImage::ImagePath
+  (std::string const& geometryFile, std::string const& key) const
+{
+  auto const iSep = geometryFile.rfind('/');
+  std::string const fileName = (iSep == std::string::npos)
+    ? geometryFile: geometryFile.substr(iSep + 1);
+  return fDirectory + fileName + '.' + key + ".chmap";
+} // geo::ChannelMapImage::ImagePath()
+
+
+//------------------------------------------------------------------------------
+std::unique_ptr<geo::ChannelMapTable const> geo::ChannelMapImage::Map(
+  geo::GeometryCore const& geom,
+  std::string const& geometryFile, std::string const& key
+) const {
+
+  std::string const path = ImagePath(geometryFile, key);
+
+  int const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return nullptr; // no image (yet)
+
+  struct stat fileInfo;
+  if ((::fstat(fd, &fileInfo) != 0)
+    || (static_cast<std::size_t>(fileInfo.st_size) < sizeof(ImageHeader_t)))
+  {
+    ::close(fd);
+    return nullptr;
+  }
+
+  std::size_t const size = fileInfo.st_size;
+  void* const address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // the mapping stays valid
+  if (address == MAP_FAILED) {
+    mf::LogWarning("ChannelMapImage")
+      << "Failed to map channel mapping image '" << path << "' in memory.";
+    return nullptr;
+  }
+  auto mapping = std::make_shared<MemoryMap_t>(address, size);
+
+  ImageHeader_t header;
+  std::memcpy(&header, mapping->data(), sizeof(header));
+
+  geo::GeometryIDIndexer indexer { geom };
+  if (!isCompatible(header, key)
+    || (header.totalSize != size)
+    || (header.nChannels != geom.Nchannels())
+    || (header.nWires != indexer.NWires())
+    )
+  {
+    mf::LogWarning("ChannelMapImage")
+      << "Channel mapping image '" << path
+      << "' does not match the current geometry; it will be ignored.";
+    return nullptr;
+  }
+
+  char const* const base = mapping->data();
+  geo::ChannelMapTable::RawData_t data;
+  data.nChannels = header.nChannels;
+  data.channelWireOffsets
+    = reinterpret_cast<std::size_t const*>(base + header.offsetsStart);
+  data.channelWires
+    = reinterpret_cast<geo::WireID const*>(base + header.wiresStart);
+  data.nWires = header.nWires;
+  data.wireChannels
+    = reinterpret_cast<raw::ChannelID_t const*>(base + header.channelsStart);
+
+  if (data.channelWireOffsets[data.nChannels] != header.nChannelWires) {
+    mf::LogWarning("ChannelMapImage")
+      << "Channel mapping image '" << path
+      << "' is corrupted; it will be ignored.";
+    return nullptr;
+  }
+
+  mf::LogInfo("ChannelMapImage")
+    << "Channel mapping tables mapped from '" << path << "'";
+
+  return std::make_unique<geo::ChannelMapTable const>
+    (geom, data, std::move(mapping));
+
+} // geo::ChannelMapImage::Map()
+
+
+//------------------------------------------------------------------------------
+bool geo::ChannelMapImage::Publish(
+  geo::ChannelMapTable const& table,
+  std::string const& geometryFile, std::string const& key
+) const {
+
+  if (key.size() >= sizeof(ImageHeader_t::key)) {
+    mf::LogWarning("ChannelMapImage")
+      << "Geometry key '" << key << "' too long for a channel mapping image.";
+    return false;
+  }
+
+  geo::ChannelMapTable::RawData_t const& data = table.Raw();
+  ImageHeader_t const header = makeHeader(data, key);
+
+  std::string const path = ImagePath(geometryFile, key);
+  std::string const tempPath
+    = path + ".tmp" + std::to_string(::getpid());
+
+  {
+    std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+
+    auto writeAt = [&out](std::uint64_t pos, void const* src, std::size_t n)
+      {
+        // pad up to the requested position
+        while (static_cast<std::uint64_t>(out.tellp()) < pos) out.put('\0');
+        out.write(static_cast<char const*>(src), n);
+      };
+
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.offsetsStart, data.channelWireOffsets,
+      (header.nChannels + 1) * header.offsetSize);
+    writeAt(header.wiresStart, data.channelWires,
+      header.nChannelWires * header.wireIDsize);
+    writeAt(header.channelsStart, data.wireChannels,
+      header.nWires * header.channelSize);
+    while (static_cast<std::uint64_t>(out.tellp()) < header.totalSize)
+      out.put('\0');
+
+    if (!out) {
+      out.close();
+      std::remove(tempPath.c_str());
+      mf::LogWarning("ChannelMapImage")
+        << "Failed to write channel mapping image '" << path << "'.";
+      return false;
+    }
+  }
+
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+    mf::LogWarning("ChannelMapImage")
+      << "Failed to move channel mapping image into '" << path << "'.";
+    return false;
+  }
+
+  mf::LogInfo("ChannelMapImage")
+    << "Channel mapping tables published into '" << path << "'";
+  return true;
+
+} // geo::ChannelMapImage::Publish()
+
+
+//------------------------------------------------------------------------------
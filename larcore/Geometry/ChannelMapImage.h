@@ -0,0 +1,101 @@
+/**
+ * @file   larcore/Geometry/ChannelMapImage.h
+ * @brief  Channel mapping tables shared among processes via memory mapping.
+ * @see    larcore/Geometry/ChannelMapImage.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_CHANNELMAPIMAGE_H
+#define LARCORE_GEOMETRY_CHANNELMAPIMAGE_H
+
+// LArSoft libraries
+#include "larcore/Geometry/ChannelMapTable.h"
+
+// C/C++ standard libraries
+#include <memory> // std::unique_ptr<>
+#include <string>
+
+
+namespace geo {
+
+  class GeometryCore;
+
+  /**
+   * @brief Read-only image of the channel mapping tables on a file.
+   *
+   * The content of a `geo::ChannelMapTable` is written into a file as a
+   * sequence of arrays, addressed by offsets, so that the file content does
+   * not depend on the address it is loaded at.
+   * Processes using the same geometry can then map that file in memory
+   * instead of building their own tables: the operating system shares the
+   * memory pages of the file among all of them.
+   * Keeping the image in a memory-backed file system (like `/dev/shm`)
+   * effectively makes it a shared memory segment.
+   *
+   * Only the channel mapping tables are shared: the ROOT geometry and the
+   * geometry objects are made of pointers into the memory of each process,
+   * and they can't be mapped from a file.
+   *
+   * Images are identified by a key (typically the one from
+   * `geo::GeometryCache::CacheKey()`, extended with all the configuration
+   * the channel mapping depends on), which is stored in the image and
+   * checked when mapping it. The image also records the layout of the data
+   * types it contains, and it is rejected when read by a process with a
+   * different layout.
+   *
+   * Images are written atomically (a temporary file is renamed into the final
+   * one), so the first process publishing the image does not disturb the
+   * others, which at worst build their own tables while the image is written.
+   */
+  class ChannelMapImage {
+
+      public:
+
+    /**
+     * @brief Constructor: sets where the images are stored.
+     * @param directory directory of the image files
+     */
+    explicit ChannelMapImage(std::string directory);
+
+    /// Returns the path of the image for the specified geometry.
+    std::string ImagePath
+      (std::string const& geometryFile, std::string const& key) const;
+
+    /**
+     * @brief Maps the image of the tables for `geom` in memory.
+     * @param geom geometry the tables are describing
+     * @param geometryFile path of the geometry description file
+     * @param key key of the geometry
+     * @return the table, or `nullptr` if no valid image is available
+     *
+     * The returned table keeps the memory mapping for as long as it exists.
+     */
+    std::unique_ptr<geo::ChannelMapTable const> Map(
+      geo::GeometryCore const& geom,
+      std::string const& geometryFile, std::string const& key
+      ) const;
+
+    /**
+     * @brief Writes the image of `table`.
+     * @param table the table to be written
+     * @param geometryFile path of the geometry description file
+     * @param key key of the geometry
+     * @return whether the image was successfully written
+     *
+     * Failures are not fatal: the image is just not published.
+     */
+    bool Publish(
+      geo::ChannelMapTable const& table,
+      std::string const& geometryFile, std::string const& key
+      ) const;
+
+
+      private:
+
+    std::string fDirectory; ///< Directory of the image files.
+
+  }; // class ChannelMapImage
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_CHANNELMAPIMAGE_H
@@ -21,6 +21,10 @@ namespace geo {
    * 
    * This class creates a `geo::ChannelMapAlg` instance.
    * 
+   * The geometry service (`geo::Geometry`) uses the tool configured in its
+   * `ChannelMapping` parameter set, creating a new tool instance for each
+   * geometry it loads, so that implementations need to support only one
+   * call.
    */
   class ChannelMapSetupTool {
       public:
@@ -0,0 +1,221 @@
+/**
+ * @file   larcore/Geometry/ChannelMapTable.cc
+ * @brief  Precomputed lookup tables for the channel mapping.
+ * @see    larcore/Geometry/ChannelMapTable.h
+ */
+
+// library header
+#include "larcore/Geometry/ChannelMapTable.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+
+// TBB libraries
+#include "tbb/parallel_for.h"
+#include "tbb/parallel_for_each.h"
+#include "tbb/blocked_range.h"
+#include "tbb/task_arena.h" // tbb::this_task_arena::isolate()
+
+// C/C++ standard libraries
+#include <algorithm> // std::copy()
+#include <utility> // std::move()
+
+
+namespace {
+
+  /// Number of channels processed in a single task.
+  constexpr raw::ChannelID_t ChannelBlockSize = 4096;
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+geo::ChannelMapTable::ChannelMapTable
+  (geo::GeometryCore const& geom, bool parallel /* = false */)
+  : fIndexer(geom)
+{
+  fillPlaneViews(geom);
+
+  auto table = std::make_shared<TableStorage_t>();
+  table->wireChannels.assign(fIndexer.NWires(), raw::InvalidChannelID);
+
+  if (parallel) {
+    // the geometry is loaded under lock: while waiting for the tasks,
+    // this thread must not steal unrelated ones which may need the lock
+    std::vector<geo::PlaneID> planes;
+    planes.reserve(fIndexer.NPlanes());
+    for (geo::PlaneID const& planeID: geom.IteratePlaneIDs())
+      planes.push_back(planeID);
+    tbb::this_task_arena::isolate([this, &geom, &table, &planes](){
+      fillChannelWiresConcurrently(geom, *table);
+      tbb::parallel_for_each(planes.begin(), planes.end(),
+        [this, &geom, &table](geo::PlaneID const& planeID)
+          { fillPlaneWireChannels(geom, planeID, *table); }
+        );
+    });
+  }
+  else {
+    fillChannelWires(geom, *table);
+    for (geo::PlaneID const& planeID: geom.IteratePlaneIDs())
+      fillPlaneWireChannels(geom, planeID, *table);
+  }
+
+  fData.nChannels = table->channelWireOffsets.size() - 1;
+  fData.channelWireOffsets = table->channelWireOffsets.data();
+  fData.channelWires = table->channelWires.data();
+  fData.nWires = table->wireChannels.size();
+  fData.wireChannels = table->wireChannels.data();
+  fStorage = std::move(table);
+
+} // geo::ChannelMapTable::ChannelMapTable()
+
+
+//------------------------------------------------------------------------------
+geo::ChannelMapTable::ChannelMapTable(
+  geo::GeometryCore const& geom,
+  RawData_t const& data,
+  std::shared_ptr<void const> storage
+)
+  : fIndexer(geom)
+  , fData(data)
+  , fStorage(std::move(storage))
+{
+  fillPlaneViews(geom);
+} // geo::ChannelMapTable::ChannelMapTable()
+
+
+//------------------------------------------------------------------------------
+std::size_t geo::ChannelMapTable::NChannelWires
+  (raw::ChannelID_t const* channels, std::size_t n) const
+{
+  std::size_t nWires = 0U;
+  for (std::size_t i = 0; i < n; ++i)
+    nWires += ChannelToWire(channels[i]).size();
+  return nWires;
+} // geo::ChannelMapTable::NChannelWires()
+
+
+//------------------------------------------------------------------------------
+void geo::ChannelMapTable::ChannelsToWires(
+  raw::ChannelID_t const* channels, std::size_t n,
+  geo::WireID* wires, std::size_t* offsets
+) const {
+  geo::WireID* dest = wires;
+  offsets[0] = 0U;
+  for (std::size_t i = 0; i < n; ++i) {
+    WireIDRange const chWires = ChannelToWire(channels[i]);
+    dest = std::copy(chWires.begin(), chWires.end(), dest);
+    offsets[i + 1] = dest - wires;
+  } // for
+} // geo::ChannelMapTable::ChannelsToWires()
+
+
+//------------------------------------------------------------------------------
+void geo::ChannelMapTable::ChannelsToViews
+  (raw::ChannelID_t const* channels, std::size_t n, geo::View_t* views) const
+{
+  for (std::size_t i = 0; i < n; ++i) views[i] = View(channels[i]);
+} // geo::ChannelMapTable::ChannelsToViews()
+
+
+//------------------------------------------------------------------------------
+void geo::ChannelMapTable::WiresToChannels(
+  geo::WireID const* wireIDs, std::size_t n, raw::ChannelID_t* channels
+) const {
+  for (std::size_t i = 0; i < n; ++i)
+    channels[i] = PlaneWireToChannel(wireIDs[i]);
+} // geo::ChannelMapTable::WiresToChannels()
+
+
+//------------------------------------------------------------------------------
+void geo::ChannelMapTable::fillPlaneViews(geo::GeometryCore const& geom) {
+  fPlaneViews.clear();
+  fPlaneViews.reserve(fIndexer.NPlanes());
+  for (geo::PlaneGeo const& plane: geom.IteratePlanes())
+    fPlaneViews.push_back(plane.View());
+} // geo::ChannelMapTable::fillPlaneViews()
+
+
+//------------------------------------------------------------------------------
+void geo::ChannelMapTable::fillChannelWires
+  (geo::GeometryCore const& geom, TableStorage_t& table) const
+{
+  unsigned int const nChannels = geom.Nchannels();
+  table.channelWireOffsets.reserve(nChannels + 1);
+  table.channelWireOffsets.push_back(0);
+  table.channelWires.reserve(fIndexer.NWires());
+  for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel) {
+    std::vector<geo::WireID> const wires = geom.ChannelToWire(channel);
+    table.channelWires.insert
+      (table.channelWires.end(), wires.begin(), wires.end());
+    table.channelWireOffsets.push_back(table.channelWires.size());
+  } // for channels
+
+} // geo::ChannelMapTable::fillChannelWires()
+
+
+//------------------------------------------------------------------------------
+void geo::ChannelMapTable::fillChannelWiresConcurrently
+  (geo::GeometryCore const& geom, TableStorage_t& table) const
+{
+  unsigned int const nChannels = geom.Nchannels();
+  std::size_t const nBlocks
+    = (nChannels + ChannelBlockSize - 1) / ChannelBlockSize;
+
+  // each block collects its own wires and the number of wires per channel
+  std::vector<std::vector<geo::WireID>> blockWires(nBlocks);
+  std::vector<std::size_t>& offsets = table.channelWireOffsets;
+  offsets.assign(nChannels + 1, 0);
+
+  // (isolated since the caller may hold locks; see the constructor)
+  tbb::this_task_arena::isolate([&](){
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, nBlocks),
+      [&](tbb::blocked_range<std::size_t> const& blocks)
+      {
+        for (std::size_t iBlock = blocks.begin(); iBlock < blocks.end();
+          ++iBlock)
+        {
+          raw::ChannelID_t const first = iBlock * ChannelBlockSize;
+          raw::ChannelID_t const last
+            = std::min<raw::ChannelID_t>(first + ChannelBlockSize, nChannels);
+          std::vector<geo::WireID>& wires = blockWires[iBlock];
+          for (raw::ChannelID_t channel = first; channel < last; ++channel)
+          {
+            std::vector<geo::WireID> const chWires
+              = geom.ChannelToWire(channel);
+            wires.insert(wires.end(), chWires.begin(), chWires.end());
+            offsets[channel + 1] = chWires.size();
+          } // for channels
+        } // for blocks
+      }
+      );
+  });
+
+  // turn per-channel counts into offsets, and join the blocks
+  for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel)
+    offsets[channel + 1] += offsets[channel];
+
+  table.channelWires.resize(offsets.back());
+  auto iDest = table.channelWires.begin();
+  for (std::vector<geo::WireID> const& wires: blockWires)
+    iDest = std::copy(wires.begin(), wires.end(), iDest);
+
+} // geo::ChannelMapTable::fillChannelWiresConcurrently()
+
+
+//------------------------------------------------------------------------------
+void geo::ChannelMapTable::fillPlaneWireChannels(
+  geo::GeometryCore const& geom, geo::PlaneID const& planeID,
+  TableStorage_t& table
+) const {
+  std::size_t const firstWire
+    = fIndexer.FirstWireIndex(fIndexer.PlaneIndex(planeID));
+  unsigned int const nWires = geom.Nwires(planeID);
+  for (unsigned int wire = 0; wire < nWires; ++wire) {
+    table.wireChannels[firstWire + wire]
+      = geom.PlaneWireToChannel(geo::WireID{ planeID, wire });
+  }
+} // geo::ChannelMapTable::fillPlaneWireChannels()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,304 @@
+/**
+ * @file   larcore/Geometry/ChannelMapTable.h
+ * @brief  Precomputed lookup tables for the channel mapping.
+ * @see    larcore/Geometry/ChannelMapTable.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_CHANNELMAPTABLE_H
+#define LARCORE_GEOMETRY_CHANNELMAPTABLE_H
+
+// LArSoft libraries
+#include "larcore/Geometry/GeometryIDIndexer.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// C/C++ standard libraries
+#include <vector>
+#include <memory> // std::shared_ptr<>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  class GeometryCore;
+
+  /**
+   * @brief Flat lookup tables of the channel mapping of a geometry.
+   *
+   * The channel mapping algorithm (`geo::ChannelMapAlg`) is queried once for
+   * each channel and each wire at construction, and the answers are stored
+   * in contiguous arrays:
+   *
+   * * for each channel, the list of wires it covers, all the lists being
+   *   stored one after the other in a single array;
+   * * for each wire, the channel covering it, stored in the dense order
+   *   defined by `geo::GeometryIDIndexer`.
+   *
+   * The queries are non-virtual and inlined, and `ChannelToWire()` does not
+   * allocate memory.
+   *
+   * Batch versions of the queries (`ChannelsToWires()`, `ChannelsToViews()`,
+   * `WiresToChannels()`) process a whole array of elements at once, writing
+   * the answers into storage provided by the caller, which can be reused
+   * across calls. For example:
+   * @code{.cpp}
+   * std::vector<std::size_t> offsets(channels.size() + 1);
+   * std::vector<geo::WireID> wires
+   *   (table.NChannelWires(channels.data(), channels.size()));
+   * table.ChannelsToWires
+   *   (channels.data(), channels.size(), wires.data(), offsets.data());
+   * @endcode
+   * fills `wires` with the wires of all the channels, the ones of
+   * `channels[i]` being from `wires[offsets[i]]` to `wires[offsets[i + 1]]`
+   * (excluded).
+   * The table is immutable and never changes with the geometry: it must be
+   * built again for each new geometry.
+   *
+   * The table can be filled concurrently by TBB tasks; in that case, the
+   * channel mapping algorithm must support concurrent queries (which is true
+   * for the `const` query interface of `geo::ChannelMapAlg`).
+   *
+   * The table content may also be stored outside of the table object, for
+   * example in a memory-mapped file shared by many processes
+   * (see `geo::ChannelMapImage`). In that case, the table keeps that storage
+   * alive via a shared pointer.
+   */
+  class ChannelMapTable {
+
+      public:
+
+    /// A contiguous range of wire IDs.
+    class WireIDRange {
+      geo::WireID const* fBegin = nullptr;
+      geo::WireID const* fEnd = nullptr;
+        public:
+      WireIDRange() = default;
+      WireIDRange(geo::WireID const* b, geo::WireID const* e)
+        : fBegin(b), fEnd(e) {}
+      geo::WireID const* begin() const { return fBegin; }
+      geo::WireID const* end() const { return fEnd; }
+      std::size_t size() const { return fEnd - fBegin; }
+      bool empty() const { return fBegin == fEnd; }
+      geo::WireID const& operator[] (std::size_t i) const { return fBegin[i]; }
+    }; // WireIDRange
+
+
+    /// Content of the table, as a set of arrays.
+    struct RawData_t {
+      /// Number of channels.
+      unsigned int nChannels = 0U;
+      /// Index of first wire of each channel in `channelWires` (`nChannels + 1`).
+      std::size_t const* channelWireOffsets = nullptr;
+      /// Wires of all channels (`channelWireOffsets[nChannels]` entries).
+      geo::WireID const* channelWires = nullptr;
+      /// Number of wires.
+      std::size_t nWires = 0U;
+      /// Channel of each wire, by dense wire index (`nWires` entries).
+      raw::ChannelID_t const* wireChannels = nullptr;
+    }; // RawData_t
+
+
+    /// Constructor: an empty table.
+    ChannelMapTable() = default;
+
+    /**
+     * @brief Constructor: fills the table from the channel mapping of `geom`.
+     * @param geom geometry with the channel mapping to be tabulated
+     * @param parallel whether to fill the table with concurrent tasks
+     */
+    explicit ChannelMapTable
+      (geo::GeometryCore const& geom, bool parallel = false);
+
+    /**
+     * @brief Constructor: uses table content stored elsewhere.
+     * @param geom geometry `data` refers to
+     * @param data the table content
+     * @param storage the owner of the memory `data` points to
+     *
+     * The table keeps a copy of `storage` for as long as it exists.
+     * The content of `data` must be consistent with `geom`; the channel
+     * mapping of `geom` is not queried.
+     */
+    ChannelMapTable(
+      geo::GeometryCore const& geom,
+      RawData_t const& data,
+      std::shared_ptr<void const> storage
+      );
+
+    /// Returns the number of channels in the table.
+    unsigned int Nchannels() const { return fData.nChannels; }
+
+    /// Returns whether the table is empty.
+    bool empty() const { return Nchannels() == 0; }
+
+    /**
+     * @brief Returns the wires covered by the specified channel.
+     * @param channel the ID of the channel
+     * @return the range of wire IDs covered by the channel
+     * @see geo::GeometryCore::ChannelToWire()
+     *
+     * An empty range is returned for invalid channels.
+     */
+    WireIDRange ChannelToWire(raw::ChannelID_t channel) const;
+
+    /**
+     * @brief Returns the channel covering the specified wire.
+     * @param wireID the ID of the wire
+     * @return the ID of the channel, or `raw::InvalidChannelID` if not found
+     * @see geo::GeometryCore::PlaneWireToChannel()
+     */
+    raw::ChannelID_t PlaneWireToChannel(geo::WireID const& wireID) const;
+
+    /**
+     * @brief Returns the view of the specified channel.
+     * @param channel the ID of the channel
+     * @return the view of the channel, or `geo::kUnknown` if invalid
+     * @see geo::GeometryCore::View(raw::ChannelID_t)
+     *
+     * The view is the one of the plane of the first wire of the channel.
+     */
+    geo::View_t View(raw::ChannelID_t channel) const;
+
+
+    /// @{
+    /// @name Batch queries
+
+    /**
+     * @brief Returns the total number of wires covered by `channels`.
+     * @param channels pointer to the first channel ID
+     * @param n number of channels
+     * @return the number of wire IDs `ChannelsToWires()` will write
+     */
+    std::size_t NChannelWires
+      (raw::ChannelID_t const* channels, std::size_t n) const;
+
+    /**
+     * @brief Writes the wires covered by each of the specified channels.
+     * @param channels pointer to the first channel ID
+     * @param n number of channels
+     * @param[out] wires where to write the wire IDs
+     * @param[out] offsets where to write the position of the wires of each
+     *                     channel (`n + 1` entries)
+     *
+     * The wires of `channels[i]` are written from `wires[offsets[i]]` on,
+     * and they are `offsets[i + 1] - offsets[i]`. `offsets[0]` is `0` and
+     * `offsets[n]` is the total number of wires, which must fit in `wires`
+     * (see `NChannelWires()`). Invalid channels cover no wire.
+     */
+    void ChannelsToWires(
+      raw::ChannelID_t const* channels, std::size_t n,
+      geo::WireID* wires, std::size_t* offsets
+      ) const;
+
+    /**
+     * @brief Writes the view of each of the specified channels.
+     * @param channels pointer to the first channel ID
+     * @param n number of channels
+     * @param[out] views where to write the views (`n` entries)
+     * @see View()
+     */
+    void ChannelsToViews
+      (raw::ChannelID_t const* channels, std::size_t n, geo::View_t* views)
+      const;
+
+    /**
+     * @brief Writes the channel covering each of the specified wires.
+     * @param wireIDs pointer to the first wire ID
+     * @param n number of wires
+     * @param[out] channels where to write the channel IDs (`n` entries)
+     * @see PlaneWireToChannel()
+     */
+    void WiresToChannels
+      (geo::WireID const* wireIDs, std::size_t n, raw::ChannelID_t* channels)
+      const;
+
+    /// @}
+
+    /// Returns the indexer of the geometry elements used in the table.
+    geo::GeometryIDIndexer const& Indexer() const { return fIndexer; }
+
+    /// Returns the content of the table.
+    RawData_t const& Raw() const { return fData; }
+
+
+      private:
+
+    /// Table content owned by the table itself.
+    struct TableStorage_t {
+      /// Index of first wire of each channel in `channelWires`, plus its size.
+      std::vector<std::size_t> channelWireOffsets;
+      /// All the wires covered by each channel, channel after channel.
+      std::vector<geo::WireID> channelWires;
+      /// Channel of each wire, by dense wire index.
+      std::vector<raw::ChannelID_t> wireChannels;
+    }; // TableStorage_t
+
+    geo::GeometryIDIndexer fIndexer; ///< Dense indexing of wire IDs.
+
+    RawData_t fData; ///< Pointers to the table content.
+
+    std::shared_ptr<void const> fStorage; ///< Owner of the table content.
+
+    std::vector<geo::View_t> fPlaneViews; ///< View of each plane, by index.
+
+
+    /// Fills the view of each plane.
+    void fillPlaneViews(geo::GeometryCore const& geom);
+
+    /// Fills the channel-to-wire table, one channel after the other.
+    void fillChannelWires
+      (geo::GeometryCore const& geom, TableStorage_t& table) const;
+
+    /// Fills the channel-to-wire table with concurrent tasks.
+    void fillChannelWiresConcurrently
+      (geo::GeometryCore const& geom, TableStorage_t& table) const;
+
+    /// Fills the wire-to-channel table of the plane `planeID`.
+    void fillPlaneWireChannels(
+      geo::GeometryCore const& geom, geo::PlaneID const& planeID,
+      TableStorage_t& table
+      ) const;
+
+  }; // class ChannelMapTable
+
+} // namespace geo
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//------------------------------------------------------------------------------
+inline geo::ChannelMapTable::WireIDRange geo::ChannelMapTable::ChannelToWire
+  (raw::ChannelID_t channel) const
+{
+  if (!raw::isValidChannelID(channel) || (channel >= Nchannels())) return {};
+  return {
+    fData.channelWires + fData.channelWireOffsets[channel],
+    fData.channelWires + fData.channelWireOffsets[channel + 1]
+    };
+} // geo::ChannelMapTable::ChannelToWire()
+
+
+//------------------------------------------------------------------------------
+inline raw::ChannelID_t geo::ChannelMapTable::PlaneWireToChannel
+  (geo::WireID const& wireID) const
+{
+  std::size_t const index = fIndexer.WireIndex(wireID);
+  return (index == geo::GeometryIDIndexer::InvalidIndex)
+    ? raw::InvalidChannelID: fData.wireChannels[index];
+} // geo::ChannelMapTable::PlaneWireToChannel()
+
+
+//------------------------------------------------------------------------------
+inline geo::View_t geo::ChannelMapTable::View(raw::ChannelID_t channel) const
+{
+  WireIDRange const wires = ChannelToWire(channel);
+  return wires.empty()
+    ? geo::kUnknown
+    : fPlaneViews[fIndexer.PlaneIndex(wires[0].asPlaneID())];
+} // geo::ChannelMapTable::View()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARCORE_GEOMETRY_CHANNELMAPTABLE_H
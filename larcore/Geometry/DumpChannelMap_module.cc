@@ -16,6 +16,8 @@
 
 // C/C++ standard libraries
 #include <string>
+#include <iosfwd> // std::ostream
+#include <cstddef> // std::size_t
 
 // ... more follow
 
@@ -24,6 +26,24 @@ namespace geo {
   class GeometryCore;
 }
 
+namespace {
+
+  /// Formats of the dump files.
+  enum class DumpFormat_t {
+    text,  ///< Human-readable, as the message facility output.
+    csv,   ///< One record per line, fields separated by `;`.
+    binary ///< Binary records of fixed size.
+  }; // DumpFormat_t
+
+  /// Options for the dump on file.
+  struct FileDumpOptions_t {
+    DumpFormat_t format = DumpFormat_t::text; ///< Format of the output.
+    std::size_t chunkSize = 4096U; ///< Elements formatted in a single chunk.
+    bool parallel = true; ///< Whether to format chunks concurrently.
+  }; // FileDumpOptions_t
+
+} // local namespace
+
 /** ****************************************************************************
  * @brief Prints on screen the current channel-wire and optical detector maps.
  *
@@ -45,6 +65,24 @@ namespace geo {
  *   printed
  * - *OutputCategory* (string, default: DumpChannelMap): output category used
  *   by the message facility to output information (INFO level)
+ * - *OutputFile* (string, default: empty): if not empty, each dump is written
+ *   directly into a file instead than via message facility; the file name is
+ *   this stem, followed by the dump name (`-ChannelToWires`, `-WireToChannel`
+ *   or `-OpDetChannels`) and by a suffix for the format (see `OutputFormat`);
+ *   the files are overwritten at each run
+ * - *OutputFormat* (string, default: `text`): format of the output files;
+ *   - `text` (suffix `.txt`): the same as the message facility output;
+ *   - `csv` (suffix `.csv`): one record per line, with fields separated by
+ *     `;` and described in a header line;
+ *   - `binary` (suffix `.bin`): a sequence of records with the same fields as
+ *     the CSV format, each field being a 32-bit unsigned integer (channel and
+ *     geometry IDs, with `0xFFFFFFFF` for invalid values) or a 64-bit floating
+ *     point number (coordinates), in the native byte order of the machine
+ * - *ChunkSize* (integer, default: 4096): the output files are formatted and
+ *   written in chunks of this many channels (or wires)
+ * - *ParallelFormatting* (boolean, default: true): chunks are formatted
+ *   concurrently, and written in order as they are completed; only a limited
+ *   number of chunks is kept in memory at any time
  *
  */
 
@@ -97,6 +135,32 @@ public:
       raw::InvalidChannelID
       };
     
+    fhicl::Atom<std::string> OutputFile {
+      Name("OutputFile"),
+      Comment(
+        "stem of the name of the dump files (default: dump via message facility)"
+        ),
+      ""
+      };
+    
+    fhicl::Atom<std::string> OutputFormat {
+      Name("OutputFormat"),
+      Comment("format of the dump files: \"text\", \"csv\" or \"binary\""),
+      "text"
+      };
+    
+    fhicl::Atom<std::size_t> ChunkSize {
+      Name("ChunkSize"),
+      Comment("number of channels (or wires) formatted in a single chunk"),
+      4096U
+      };
+    
+    fhicl::Atom<bool> ParallelFormatting {
+      Name("ParallelFormatting"),
+      Comment("format the chunks of the dump files concurrently"),
+      true
+      };
+    
   }; // Config
   
   using Parameters = art::EDAnalyzer::Table<Config>;
@@ -126,6 +190,12 @@ public:
   raw::ChannelID_t FirstChannel; ///< First channel to be printed.
   raw::ChannelID_t LastChannel; ///< Last channel to be printed.
 
+  std::string OutputFile; ///< Stem of the dump file names (empty: no files).
+  FileDumpOptions_t FileOptions; ///< Options for the dump on files.
+
+  /// Returns the name of the file for the specified dump.
+  std::string OutputFileName(std::string const& dumpName) const;
+
 }; // geo::DumpChannelMap
 
 
@@ -136,6 +206,8 @@ public:
 namespace geo {
   class GeometryCore;
   class OpDetGeo;
+  class OpticalChannelIndex;
+  class GeometryIDTable;
 } // namespace geo
 
 namespace {
@@ -162,6 +234,9 @@ namespace {
     /// Dumps to the specified output category
     void Dump(std::string OutputCategory) const;
 
+    /// Writes the dump into the specified stream
+    void Write(std::ostream& out, FileDumpOptions_t const& options) const;
+
 
       protected:
     geo::GeometryCore const* pGeom = nullptr; ///< pointer to geometry
@@ -183,16 +258,23 @@ namespace {
     DumpWireToChannel() {}
 
     /// Sets up the required environment
-    void Setup(geo::GeometryCore const& geometry)
-      { pGeom = &geometry; }
+    void Setup
+      (geo::GeometryCore const& geometry, geo::GeometryIDTable const& idTable)
+      { pGeom = &geometry; pIDTable = &idTable; }
 
     /// Dumps to the specified output category
     void Dump(std::string OutputCategory) const;
 
+    /// Writes the dump into the specified stream
+    void Write(std::ostream& out, FileDumpOptions_t const& options) const;
+
 
       protected:
     geo::GeometryCore const* pGeom = nullptr; ///< pointer to geometry
 
+    /// Flat arrays of wires and their channels.
+    geo::GeometryIDTable const* pIDTable = nullptr;
+
     /// Throws an exception if the object is not ready to dump
     void CheckConfig() const;
 
@@ -207,16 +289,25 @@ namespace {
     DumpOpticalDetectorChannels() {}
 
     /// Sets up the required environment
-    void Setup(geo::GeometryCore const& geometry)
-      { pGeom = &geometry; }
+    void Setup(
+      geo::GeometryCore const& geometry,
+      geo::OpticalChannelIndex const& opChannelIndex
+      )
+      { pGeom = &geometry; pOpChannelIndex = &opChannelIndex; }
 
     /// Dumps to the specified output category
     void Dump(std::string OutputCategory) const;
 
+    /// Writes the dump into the specified stream
+    void Write(std::ostream& out, FileDumpOptions_t const& options) const;
+
 
       protected:
     geo::GeometryCore const* pGeom = nullptr; ///< pointer to geometry
 
+    /// Map of the optical channels.
+    geo::OpticalChannelIndex const* pOpChannelIndex = nullptr;
+
     /// Throws an exception if the object is not ready to dump
     void CheckConfig() const;
 
@@ -227,6 +318,12 @@ namespace {
   }; // class DumpOpticalDetectorChannels
 
 
+  /// Returns the format with the specified name.
+  DumpFormat_t parseDumpFormat(std::string const& name);
+
+  /// Returns the file name suffix for the specified format.
+  std::string dumpFormatSuffix(DumpFormat_t format);
+
 } // local namespace
 
 
@@ -238,9 +335,16 @@ namespace {
 #include "larcore/Geometry/Geometry.h"
 #include "larcorealg/Geometry/GeometryCore.h"
 #include "larcorealg/Geometry/OpDetGeo.h"
+#include "larcore/Geometry/OpticalChannelIndex.h"
+#include "larcore/Geometry/GeometryIDTable.h"
 
 // framework libraries
 #include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "canvas/Utilities/Exception.h"
+
+// C/C++ standard libraries
+#include <fstream>
 
 //------------------------------------------------------------------------------
 geo::DumpChannelMap::DumpChannelMap(Parameters const& config)
@@ -251,33 +355,68 @@ geo::DumpChannelMap::DumpChannelMap(Parameters const& config)
   , DoOpDetChannels (config().OpDetChannels())
   , FirstChannel    (config().FirstChannel())
   , LastChannel     (config().LastChannel())
+  , OutputFile      (config().OutputFile())
 {
-
+  FileOptions.format = parseDumpFormat(config().OutputFormat());
+  FileOptions.chunkSize = config().ChunkSize();
+  FileOptions.parallel = config().ParallelFormatting();
+  if (FileOptions.chunkSize == 0) {
+    throw art::Exception(art::errors::Configuration)
+      << "DumpChannelMap: ChunkSize must be positive.\n";
+  }
 } // geo::DumpChannelMap::DumpChannelMap()
 
+//------------------------------------------------------------------------------
+std::string geo::DumpChannelMap::OutputFileName
+  (std::string const& dumpName) const
+{
+  return OutputFile + '-' + dumpName + dumpFormatSuffix(FileOptions.format);
+} // geo::DumpChannelMap::OutputFileName()
+
 //------------------------------------------------------------------------------
 void geo::DumpChannelMap::beginRun(art::Run const&) {
 
-  geo::GeometryCore const& geom = *(art::ServiceHandle<geo::Geometry const>());
+  geo::Geometry const& geomService = *(art::ServiceHandle<geo::Geometry const>());
+  geo::GeometryCore const& geom = *(geomService.provider());
+
+  // keeps the precomputed geometry information alive during the dump
+  auto const geomSnapshot = geomService.Snapshot();
+
+  // dumps via message facility, or into a file
+  auto runDumper = [this](auto const& dumper, std::string const& dumpName)
+    {
+      if (OutputFile.empty()) {
+        dumper.Dump(OutputCategory);
+        return;
+      }
+      std::string const fileName = OutputFileName(dumpName);
+      std::ofstream out(fileName, std::ios::binary | std::ios::trunc);
+      dumper.Write(out, FileOptions);
+      if (!out) {
+        throw art::Exception(art::errors::FileWriteError)
+          << "DumpChannelMap: failed to write '" << fileName << "'\n";
+      }
+      mf::LogInfo(OutputCategory) << "Dump written into '" << fileName << "'";
+    };
 
   if (DoChannelToWires) {
     DumpChannelToWires dumper;
     dumper.Setup(geom);
     dumper.SetLimits(FirstChannel, LastChannel);
-    dumper.Dump(OutputCategory);
+    runDumper(dumper, "ChannelToWires");
   }
 
   if (DoWireToChannel) {
     DumpWireToChannel dumper;
-    dumper.Setup(geom);
+    dumper.Setup(geom, *(geomSnapshot->IDTable()));
   //  dumper.SetLimits(FirstChannel, LastChannel);
-    dumper.Dump(OutputCategory);
+    runDumper(dumper, "WireToChannel");
   }
 
   if (DoOpDetChannels) {
     DumpOpticalDetectorChannels dumper;
-    dumper.Setup(geom);
-    dumper.Dump(OutputCategory);
+    dumper.Setup(geom, *(geomSnapshot->OpChannelIndex()));
+    runDumper(dumper, "OpDetChannels");
   }
 
 } // geo::DumpChannelMap::beginRun()
@@ -297,7 +436,120 @@ DEFINE_ART_MODULE(geo::DumpChannelMap)
 #include "messagefacility/MessageLogger/MessageLogger.h"
 #include "canvas/Utilities/Exception.h"
 
+// TBB libraries
+#include "tbb/parallel_for.h"
+
 // C/C++ standard libraries
+#include <ostream>
+#include <sstream>
+#include <vector>
+#include <algorithm> // std::min()
+#include <cstdint> // std::uint32_t
+#include <cstring> // std::memcpy()
+
+//------------------------------------------------------------------------------
+//--- file dump utilities
+//------------------------------------------------------------------------------
+namespace {
+
+  /// Maximum number of formatted chunks kept in memory at the same time.
+  constexpr std::size_t ChunksInFlight = 32U;
+
+  /// Value used for invalid IDs in binary records.
+  constexpr std::uint32_t InvalidBinaryID = 0xFFFFFFFF;
+
+
+  /**
+   * @brief Writes `n` elements into `out`, formatting them in chunks.
+   * @param out stream to write into
+   * @param n number of elements to be written
+   * @param options options for the chunks
+   * @param format function formatting elements `[ begin, end )` into a string
+   *
+   * The elements are formatted in chunks of `options.chunkSize`, up to
+   * `ChunksInFlight` of them concurrently if `options.parallel` is set, and
+   * the chunks are written in order.
+   * The `format` function must then support concurrent calls.
+   */
+  template <typename Format>
+  void writeInChunks(
+    std::ostream& out, std::size_t n, FileDumpOptions_t const& options,
+    Format format
+  ) {
+    std::size_t const nChunks = (n + options.chunkSize - 1) / options.chunkSize;
+    std::vector<std::string> chunks(std::min(nChunks, ChunksInFlight));
+
+    auto formatChunk = [&](std::size_t iChunk, std::string& buffer)
+      {
+        std::size_t const begin = iChunk * options.chunkSize;
+        std::size_t const end = std::min(begin + options.chunkSize, n);
+        buffer.clear();
+        format(begin, end, buffer);
+      };
+
+    for (std::size_t first = 0; first < nChunks; first += chunks.size()) {
+      std::size_t const nBatch = std::min(chunks.size(), nChunks - first);
+      if (options.parallel) {
+        tbb::parallel_for(std::size_t(0), nBatch,
+          [&](std::size_t i){ formatChunk(first + i, chunks[i]); });
+      }
+      else {
+        for (std::size_t i = 0; i < nBatch; ++i)
+          formatChunk(first + i, chunks[i]);
+      }
+      for (std::size_t i = 0; i < nBatch; ++i)
+        out.write(chunks[i].data(), chunks[i].size());
+      if (!out) break;
+    } // for batches
+
+  } // writeInChunks()
+
+
+  /// Appends the binary representation of `value` to `buffer`.
+  template <typename T>
+  void appendBinary(std::string& buffer, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    buffer.append(bytes, sizeof(T));
+  } // appendBinary()
+
+
+  /// Appends the binary record of a wire ID (4 IDs) to `buffer`.
+  void appendBinary(std::string& buffer, geo::WireID const& wireID) {
+    appendBinary<std::uint32_t>(buffer, wireID.Cryostat);
+    appendBinary<std::uint32_t>(buffer, wireID.TPC);
+    appendBinary<std::uint32_t>(buffer, wireID.Plane);
+    appendBinary<std::uint32_t>(buffer, wireID.Wire);
+  } // appendBinary(WireID)
+
+
+  /// Returns the binary representation of a channel ID.
+  std::uint32_t binaryChannel(raw::ChannelID_t channel)
+    { return raw::isValidChannelID(channel)? channel: InvalidBinaryID; }
+
+  //----------------------------------------------------------------------------
+  DumpFormat_t parseDumpFormat(std::string const& name) {
+    if (name == "text")   return DumpFormat_t::text;
+    if (name == "csv")    return DumpFormat_t::csv;
+    if (name == "binary") return DumpFormat_t::binary;
+    throw art::Exception(art::errors::Configuration)
+      << "DumpChannelMap: unsupported output format '" << name
+      << "' (supported: \"text\", \"csv\", \"binary\")\n";
+  } // parseDumpFormat()
+
+
+  //----------------------------------------------------------------------------
+  std::string dumpFormatSuffix(DumpFormat_t format) {
+    switch (format) {
+      case DumpFormat_t::text:   return ".txt";
+      case DumpFormat_t::csv:    return ".csv";
+      case DumpFormat_t::binary: return ".bin";
+    } // switch
+    return "";
+  } // dumpFormatSuffix()
+
+} // local namespace
+
 
 //------------------------------------------------------------------------------
 //--- DumpChannelToWires
@@ -361,13 +613,79 @@ void DumpChannelToWires::Dump(std::string OutputCategory) const {
 
 } // DumpChannelToWires::Dump()
 
+//------------------------------------------------------------------------------
+void DumpChannelToWires::Write
+  (std::ostream& out, FileDumpOptions_t const& options) const
+{
+  /// check that the configuration is complete
+  CheckConfig();
+
+  unsigned int const NChannels = pGeom->Nchannels();
+  if (NChannels == 0) return;
+
+  raw::ChannelID_t const PrintFirst
+    = raw::isValidChannelID(FirstChannel)? FirstChannel: raw::ChannelID_t(0);
+  raw::ChannelID_t const PrintLast
+    = raw::isValidChannelID(LastChannel)? LastChannel: raw::ChannelID_t(NChannels-1);
+  if (PrintLast < PrintFirst) return;
+
+  if (options.format == DumpFormat_t::csv)
+    out << "channel;cryostat;tpc;plane;wire\n";
+
+  auto format = [this, PrintFirst, &options]
+    (std::size_t begin, std::size_t end, std::string& buffer)
+    {
+      std::ostringstream sstr;
+      for (std::size_t i = begin; i < end; ++i) {
+        raw::ChannelID_t const channel = PrintFirst + i;
+        std::vector<geo::WireID> const Wires = pGeom->ChannelToWire(channel);
+        switch (options.format) {
+          case DumpFormat_t::text:
+            sstr << " " << ((int) channel) << " ->";
+            switch (Wires.size()) {
+              case 0:  sstr << " no wires";                       break;
+              case 1:                                             break;
+              default: sstr << " [" << Wires.size() << " wires]"; break;
+            } // switch
+            for (geo::WireID const& wireID: Wires)
+              sstr << " { " << std::string(wireID) << " };";
+            sstr << "\n";
+            break;
+          case DumpFormat_t::csv:
+            if (Wires.empty()) sstr << channel << ";;;;\n";
+            for (geo::WireID const& wireID: Wires) {
+              sstr << channel << ';' << wireID.Cryostat << ';' << wireID.TPC
+                << ';' << wireID.Plane << ';' << wireID.Wire << '\n';
+            }
+            break;
+          case DumpFormat_t::binary:
+            if (Wires.empty()) {
+              appendBinary<std::uint32_t>(buffer, channel);
+              appendBinary(buffer, geo::WireID{
+                InvalidBinaryID, InvalidBinaryID, InvalidBinaryID, InvalidBinaryID
+                });
+            }
+            for (geo::WireID const& wireID: Wires) {
+              appendBinary<std::uint32_t>(buffer, channel);
+              appendBinary(buffer, wireID);
+            }
+            break;
+        } // switch
+      } // for channels
+      buffer += sstr.str();
+    };
+
+  writeInChunks(out, (PrintLast - PrintFirst) + 1, options, format);
+
+} // DumpChannelToWires::Write()
+
 //------------------------------------------------------------------------------
 //--- DumpWireToChannel
 //------------------------------------------------------------------------------
 void DumpWireToChannel::CheckConfig() const {
 
   /// check that the configuration is complete
-  if (!pGeom) {
+  if (!pGeom || !pIDTable) {
     throw art::Exception(art::errors::LogicError)
       << "DumpWireToChannel: no valid geometry available!";
   }
@@ -394,8 +712,11 @@ void DumpWireToChannel::Dump(std::string OutputCategory) const {
 
   // print map
   mf::LogVerbatim log(OutputCategory);
-  for (geo::WireID const& wireID: pGeom->IterateWireIDs()) {
-    raw::ChannelID_t channel = pGeom->PlaneWireToChannel(wireID);
+  auto const wireIDs = pIDTable->Wires();
+  auto const wireChannels = pIDTable->WireChannels();
+  for (std::size_t i = 0; i < wireIDs.size(); ++i) {
+    geo::WireID const& wireID = wireIDs[i];
+    raw::ChannelID_t const channel = wireChannels[i];
     log << "\n { " << std::string(wireID) << " } => ";
     if (raw::isValidChannelID(channel)) log << channel;
     else                                log << "invalid!";
@@ -403,6 +724,52 @@ void DumpWireToChannel::Dump(std::string OutputCategory) const {
 
 } // DumpWireToChannel::Dump()
 
+//------------------------------------------------------------------------------
+void DumpWireToChannel::Write
+  (std::ostream& out, FileDumpOptions_t const& options) const
+{
+  /// check that the configuration is complete
+  CheckConfig();
+
+  auto const wireIDs = pIDTable->Wires();
+  auto const wireChannels = pIDTable->WireChannels();
+
+  if (options.format == DumpFormat_t::csv)
+    out << "cryostat;tpc;plane;wire;channel\n";
+
+  auto format = [&wireIDs, &wireChannels, &options]
+    (std::size_t begin, std::size_t end, std::string& buffer)
+    {
+      std::ostringstream sstr;
+      for (std::size_t i = begin; i < end; ++i) {
+        geo::WireID const& wireID = wireIDs[i];
+        raw::ChannelID_t const channel = wireChannels[i];
+        switch (options.format) {
+          case DumpFormat_t::text:
+            sstr << " { " << std::string(wireID) << " } => ";
+            if (raw::isValidChannelID(channel)) sstr << channel;
+            else                                sstr << "invalid!";
+            sstr << "\n";
+            break;
+          case DumpFormat_t::csv:
+            sstr << wireID.Cryostat << ';' << wireID.TPC << ';' << wireID.Plane
+              << ';' << wireID.Wire << ';';
+            if (raw::isValidChannelID(channel)) sstr << channel;
+            sstr << '\n';
+            break;
+          case DumpFormat_t::binary:
+            appendBinary(buffer, wireID);
+            appendBinary(buffer, binaryChannel(channel));
+            break;
+        } // switch
+      } // for wires
+      buffer += sstr.str();
+    };
+
+  writeInChunks(out, wireIDs.size(), options, format);
+
+} // DumpWireToChannel::Write()
+
 
 //------------------------------------------------------------------------------
 //--- DumpOpticalDetectorChannels
@@ -414,6 +781,10 @@ void DumpOpticalDetectorChannels::CheckConfig() const {
     throw art::Exception(art::errors::LogicError)
       << "DumpOpticalDetectorChannels: no valid geometry available!";
   }
+  if (!pOpChannelIndex) {
+    throw art::Exception(art::errors::LogicError)
+      << "DumpOpticalDetectorChannels: no optical channel map available!";
+  }
 } // DumpOpticalDetectorChannels::CheckConfig()
 
 
@@ -421,12 +792,7 @@ void DumpOpticalDetectorChannels::CheckConfig() const {
 geo::OpDetGeo const* DumpOpticalDetectorChannels::getOpticalDetector
   (unsigned int channelID) const
 {
-  try {
-    return &(pGeom->OpDetGeoFromOpChannel(channelID));
-  }
-  catch (cet::exception const&) {
-    return nullptr;
-  }
+  return pOpChannelIndex->OpDetGeoFromOpChannel(*pGeom, channelID);
 } // DumpOpticalDetectorChannels::getOpticalDetector()
 
 
@@ -465,4 +831,66 @@ void DumpOpticalDetectorChannels::Dump(std::string OutputCategory) const {
 } // DumpOpticalDetectorChannels::Dump()
 
 
+//------------------------------------------------------------------------------
+void DumpOpticalDetectorChannels::Write
+  (std::ostream& out, FileDumpOptions_t const& options) const
+{
+  /// check that the configuration is complete
+  CheckConfig();
+
+  unsigned int const NChannels = pGeom->NOpChannels();
+
+  if (options.format == DumpFormat_t::csv)
+    out << "channel;opdet;x;y;z\n";
+
+  auto format = [this, &options]
+    (std::size_t begin, std::size_t end, std::string& buffer)
+    {
+      std::ostringstream sstr;
+      for (std::size_t channelID = begin; channelID < end; ++channelID) {
+        geo::OpDetGeo const* opDet = getOpticalDetector(channelID);
+        switch (options.format) {
+          case DumpFormat_t::text:
+            sstr << "Channel " << channelID << " => ";
+            if (opDet)
+              sstr << opDet->ID() << " at " << opDet->GetCenter() << " cm";
+            else
+              sstr << "invalid";
+            sstr << "\n";
+            break;
+          case DumpFormat_t::csv:
+            sstr << channelID << ';';
+            if (opDet) {
+              auto const& center = opDet->GetCenter();
+              sstr << opDet->ID().OpDet << ';' << center.X()
+                << ';' << center.Y() << ';' << center.Z();
+            }
+            else sstr << ";;;";
+            sstr << '\n';
+            break;
+          case DumpFormat_t::binary: {
+            appendBinary<std::uint32_t>(buffer, channelID);
+            if (opDet) {
+              auto const& center = opDet->GetCenter();
+              appendBinary<std::uint32_t>(buffer, opDet->ID().OpDet);
+              appendBinary<double>(buffer, center.X());
+              appendBinary<double>(buffer, center.Y());
+              appendBinary<double>(buffer, center.Z());
+            }
+            else {
+              appendBinary<std::uint32_t>(buffer, InvalidBinaryID);
+              for (int i = 0; i < 3; ++i) appendBinary<double>(buffer, 0.0);
+            }
+            break;
+          }
+        } // switch
+      } // for channels
+      buffer += sstr.str();
+    };
+
+  writeInChunks(out, NChannels, options, format);
+
+} // DumpOpticalDetectorChannels::Write()
+
+
 //==============================================================================
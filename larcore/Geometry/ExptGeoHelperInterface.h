@@ -26,10 +26,12 @@
 // framework libraries
 #include "art/Framework/Services/Registry/ServiceMacros.h"
 #include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/demangle.h"
 
 // C/C++ standard libraries
 #include <memory> // std::shared_ptr<>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 // prototypes of geometry classes
@@ -82,8 +84,35 @@ namespace geo
       return doConfigureChannelMapAlg(sortingParameters, detectorName);
     }
 
+    /**
+     * @brief Returns a key identifying this helper and its configuration
+     *
+     * Information derived from the channel mapping (e.g. shared channel
+     * mapping tables) is valid only for the same key. The key includes the
+     * implementation, and the configuration passed to the constructor, if
+     * any.
+     */
+    std::string ConfigurationKey() const { return doConfigurationKey(); }
+
+  protected:
+
+    ExptGeoHelperInterface() = default;
+
+    /// Constructor: includes `config` in the `ConfigurationKey()`.
+    explicit ExptGeoHelperInterface(fhicl::ParameterSet const& config)
+      : fConfigID(config.id().to_string())
+      {}
+
   private:
 
+    std::string fConfigID; ///< Identifier of the helper configuration.
+
+    /// Returns the implementation name and the configuration identifier.
+    virtual std::string doConfigurationKey() const
+    {
+      return cet::demangle_symbol(typeid(*this).name()) + '|' + fConfigID;
+    }
+
     virtual
     ChannelMapAlgPtr_t
     doConfigureChannelMapAlg(fhicl::ParameterSet const& sortingParameters,
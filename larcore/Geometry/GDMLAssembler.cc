@@ -0,0 +1,245 @@
+/**
+ * @file   larcore/Geometry/GDMLAssembler.cc
+ * @brief  Assembles a GDML detector description from fragments, in memory.
+ * @see    larcore/Geometry/GDMLAssembler.h
+ */
+
+// library header
+#include "larcore/Geometry/GDMLAssembler.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <fstream>
+#include <sstream>
+
+
+namespace {
+
+  /// Returns `s` without leading and trailing white space.
+  std::string trimmed(std::string const& s) {
+    auto const begin = s.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) return {};
+    auto const end = s.find_last_not_of(" \t\r\n");
+    return s.substr(begin, end + 1 - begin);
+  } // trimmed()
+
+
+  /// Returns the value of `attr="value"` in `line`, if present.
+  bool attributeValue
+    (std::string const& line, std::string const& attr, std::string& value)
+  {
+    std::string const key = attr + "=\"";
+    auto const begin = line.find(key);
+    if (begin == std::string::npos) return false;
+    auto const valueBegin = begin + key.length();
+    auto const end = line.find('"', valueBegin);
+    if (end == std::string::npos) return false;
+    value = line.substr(valueBegin, end - valueBegin);
+    return true;
+  } // attributeValue()
+
+
+  /// Returns the content of all the `<tag>` elements within `text`.
+  std::vector<std::string> elementContents
+    (std::string const& text, std::string const& tag)
+  {
+    std::string const open = '<' + tag + '>', close = "</" + tag + '>';
+    std::vector<std::string> contents;
+    std::size_t pos = 0;
+    while ((pos = text.find(open, pos)) != std::string::npos) {
+      auto const begin = pos + open.length();
+      auto const end = text.find(close, begin);
+      if (end == std::string::npos) break;
+      contents.push_back(text.substr(begin, end - begin));
+      pos = end + close.length();
+    } // while
+    return contents;
+  } // elementContents()
+
+
+  /// Replaces all the occurrences of `from` in `text` with `to`.
+  void replaceAll
+    (std::string& text, std::string const& from, std::string const& to)
+  {
+    if (from.empty()) return;
+    auto pos = text.find(from);
+    if (pos == std::string::npos) return;
+
+    std::string result;
+    result.reserve(text.size());
+    std::size_t last = 0;
+    do {
+      result.append(text, last, pos - last);
+      result.append(to);
+      last = pos + from.length();
+    } while ((pos = text.find(from, last)) != std::string::npos);
+    result.append(text, last, std::string::npos);
+    text = std::move(result);
+  } // replaceAll()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+std::vector<std::string> const geo::GDMLAssembler::Keywords
+  { "define", "materials", "solids", "structure" };
+
+
+//------------------------------------------------------------------------------
+void geo::GDMLAssembler::AddConstantFile(std::string const& path)
+  { AddConstants(fileContent(path)); }
+
+
+//------------------------------------------------------------------------------
+void geo::GDMLAssembler::AddConstants(std::string const& text) {
+
+  // e.g. `<constant name="kInch" value="2.54" />`: one definition per line
+  std::istringstream lines(text);
+  std::string line;
+  while (std::getline(lines, line)) {
+    auto const start = line.find_first_not_of(" \t");
+    if ((start == std::string::npos) || line.compare(start, 10, "<constant "))
+      continue;
+    std::string name, value;
+    if (!attributeValue(line, "name", name)) continue;
+    if (!attributeValue(line, "value", value)) continue;
+    // parentheses avoid problems with arithmetic
+    fConstants.emplace_back(std::move(name), '(' + value + ')');
+  } // while
+
+} // geo::GDMLAssembler::AddConstants()
+
+
+//------------------------------------------------------------------------------
+void geo::GDMLAssembler::AddFragmentFile(std::string const& path)
+  { AddFragment(fileContent(path)); }
+
+
+//------------------------------------------------------------------------------
+void geo::GDMLAssembler::AddFragment(std::string const& text) {
+
+  std::string fragment = text;
+
+  for (std::string const& keyword: Keywords) {
+    std::string const open = '<' + keyword + '>';
+    std::string const close = "</" + keyword + '>';
+    std::string& block = fBlocks[keyword];
+
+    // as `make_gdml.pl` does, blocks are extracted starting from the last one
+    std::size_t pos = fragment.rfind(open);
+    while (pos != std::string::npos) {
+      auto const end = fragment.find(close, pos + open.length());
+      if (end == std::string::npos) {
+        if (pos == 0) break;
+        pos = fragment.rfind(open, pos - 1);
+        continue;
+      }
+      auto const begin = pos + open.length();
+      block.append(fragment, begin, end - begin);
+      fragment.erase(pos, end + close.length() - pos);
+      pos = fragment.rfind(open);
+    } // while
+  } // for keywords
+
+} // geo::GDMLAssembler::AddFragment()
+
+
+//------------------------------------------------------------------------------
+void geo::GDMLAssembler::AddConfiguration(std::string const& configPath) {
+  std::istringstream config(fileContent(configPath));
+  AddConfiguration(config);
+} // geo::GDMLAssembler::AddConfiguration(std::string)
+
+
+//------------------------------------------------------------------------------
+void geo::GDMLAssembler::AddConfiguration(std::istream& configStream) {
+
+  std::ostringstream configText;
+  configText << configStream.rdbuf();
+  std::string config = configText.str();
+
+  // remove the comments, which might contain anything
+  std::size_t pos = 0;
+  while ((pos = config.find("<!--", pos)) != std::string::npos) {
+    auto const end = config.find("-->", pos);
+    config.erase(pos, (end == std::string::npos)? end: end + 3 - pos);
+  }
+
+  for (std::string const& section: elementContents(config, "constantfiles")) {
+    for (std::string const& fileName: elementContents(section, "filename"))
+      AddConstantFile(trimmed(fileName));
+  }
+  for (std::string const& section: elementContents(config, "gdmlfiles")) {
+    for (std::string const& fileName: elementContents(section, "filename"))
+      AddFragmentFile(trimmed(fileName));
+  }
+
+} // geo::GDMLAssembler::AddConfiguration(std::istream)
+
+
+//------------------------------------------------------------------------------
+std::string geo::GDMLAssembler::Assemble() const {
+  std::ostringstream out;
+  Write(out);
+  return out.str();
+} // geo::GDMLAssembler::Assemble()
+
+
+//------------------------------------------------------------------------------
+void geo::GDMLAssembler::Write(std::ostream& out) const {
+
+  out << "<?xml version=\"1.0\" encoding=\"UTF-8\" ?>\n"
+    "<gdml xmlns:gdml=\"http://cern.ch/2001/Schemas/GDML\"\n"
+    "      xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\"\n"
+    "      xsi:noNamespaceSchemaLocation=\"GDMLSchema/gdml.xsd\">\n";
+
+  for (std::string const& keyword: Keywords) {
+    auto const iBlock = fBlocks.find(keyword);
+    std::string block
+      = (iBlock == fBlocks.end())? std::string{}: iBlock->second;
+
+    // constants are replaced in reverse order, to resolve dependencies
+    for (auto iC = fConstants.rbegin(); iC != fConstants.rend(); ++iC)
+      replaceAll(block, iC->first, iC->second);
+
+    out << '<' << keyword << '>' << block << "</" << keyword << ">\n";
+  } // for keywords
+
+  out << "\n"
+    "<setup name=\"Default\" version=\"1.0\">\n"
+    "  <world ref=\"volWorld\" />\n"
+    "</setup>\n"
+    "\n"
+    "</gdml>\n";
+
+} // geo::GDMLAssembler::Write()
+
+
+//------------------------------------------------------------------------------
+void geo::GDMLAssembler::Reset() {
+  fConstants.clear();
+  fBlocks.clear();
+} // geo::GDMLAssembler::Reset()
+
+
+//------------------------------------------------------------------------------
+std::string const& geo::GDMLAssembler::fileContent(std::string const& path) {
+
+  auto const iFile = fFileCache.find(path);
+  if (iFile != fFileCache.end()) return iFile->second;
+
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw cet::exception("GDMLAssembler")
+      << "Could not open file '" << path << "' for read.\n";
+  }
+  std::ostringstream content;
+  content << file.rdbuf();
+  return fFileCache.emplace(path, content.str()).first->second;
+
+} // geo::GDMLAssembler::fileContent()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+/**
+ * @file   larcore/Geometry/GDMLAssembler.h
+ * @brief  Assembles a GDML detector description from fragments, in memory.
+ * @see    larcore/Geometry/GDMLAssembler.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GDMLASSEMBLER_H
+#define LARCORE_GEOMETRY_GDMLASSEMBLER_H
+
+// C/C++ standard libraries
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility> // std::pair<>
+#include <vector>
+
+
+namespace geo {
+
+  /**
+   * @brief Builds a complete GDML file out of GDML fragments.
+   *
+   * This is the C++ equivalent of `make_gdml.pl`, and it produces the same
+   * output. The description is made of:
+   *
+   * * _constant files_, whose `<constant name="..." value="..." />` lines
+   *   define constants which are replaced by their (parenthesized) value in
+   *   the output, since the ROOT GDML parser does not support them;
+   * * _fragments_, whose `<define>`, `<materials>`, `<solids>` and
+   *   `<structure>` blocks are merged, in this order, into the output.
+   *
+   * Both can be added as files or directly as text (`AddConstants()`,
+   * `AddFragment()`), so that a geometry generator can pass its fragments
+   * without writing them to disk. The content of files is read only once,
+   * even when the same assembler is used to produce several descriptions
+   * (e.g. with and without wires) sharing most of their fragments: see
+   * `Reset()`.
+   *
+   * The list of files can also be read from the XML configuration used by
+   * `make_gdml.pl` (`AddConfiguration()`), with `<constantfiles>` and
+   * `<gdmlfiles>` sections listing `<filename>` elements.
+   *
+   * Errors (like unreadable files) are reported by throwing
+   * `cet::exception` (category `"GDMLAssembler"`).
+   */
+  class GDMLAssembler {
+
+      public:
+
+    /// Adds all the constants defined in the specified file.
+    void AddConstantFile(std::string const& path);
+
+    /// Adds all the constants defined in the specified GDML text.
+    void AddConstants(std::string const& text);
+
+    /// Adds the GDML fragment in the specified file.
+    void AddFragmentFile(std::string const& path);
+
+    /// Adds the specified GDML fragment.
+    void AddFragment(std::string const& text);
+
+    /// Adds the constant files and fragments listed in a configuration file.
+    void AddConfiguration(std::string const& configPath);
+
+    /// Adds the constant files and fragments listed in a configuration stream.
+    void AddConfiguration(std::istream& config);
+
+    /// Returns the complete GDML description.
+    std::string Assemble() const;
+
+    /// Writes the complete GDML description into `out`.
+    void Write(std::ostream& out) const;
+
+    /// Removes all constants and fragments, keeping the cache of file content.
+    void Reset();
+
+
+      private:
+
+    /// Blocks in the output, in order.
+    static std::vector<std::string> const Keywords;
+
+    /// Constants, in definition order: name and replacement.
+    std::vector<std::pair<std::string, std::string>> fConstants;
+
+    /// Collected content of each block, by keyword.
+    std::map<std::string, std::string> fBlocks;
+
+    /// Content of the files read so far, by path.
+    std::map<std::string, std::string> fFileCache;
+
+    /// Returns the content of the file at `path` (cached).
+    std::string const& fileContent(std::string const& path);
+
+  }; // class GDMLAssembler
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GDMLASSEMBLER_H
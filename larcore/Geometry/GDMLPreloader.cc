@@ -0,0 +1,165 @@
+/**
+ * @file   larcore/Geometry/GDMLPreloader.cc
+ * @brief  Concurrent pre-reading and check of large GDML files.
+ * @see    larcore/Geometry/GDMLPreloader.h
+ */
+
+// library header
+#include "larcore/Geometry/GDMLPreloader.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// TBB libraries
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h" // tbb::this_task_arena::isolate()
+
+// C/C++ standard libraries
+#include <algorithm> // std::max()
+#include <array>
+#include <vector>
+#include <cstring> // std::memchr(), std::strerror()
+#include <cerrno>
+#include <fcntl.h> // open()
+#include <sys/mman.h> // mmap(), munmap(), madvise()
+#include <sys/stat.h> // fstat()
+#include <unistd.h> // close()
+
+
+namespace {
+
+  /// Element names counted in the file (closing tags start with `/`).
+  enum Tag_t: std::size_t {
+    tGDML, tSolids, tSolidsEnd, tStructure, tStructureEnd,
+    tTube, tVolume, tPhysVol,
+    NTags
+  }; // Tag_t
+
+  constexpr std::array<char const*, NTags> TagNames {{
+    "gdml", "solids", "/solids", "structure", "/structure",
+    "tube", "volume", "physvol"
+  }};
+
+  using Counts_t = std::array<std::size_t, NTags>;
+
+
+  /// Counts the elements starting within `[begin, end)`; reads up to `last`.
+  Counts_t countTags(char const* begin, char const* end, char const* last) {
+    Counts_t counts {};
+    char const* p = begin;
+    while (p < end) {
+      p = static_cast<char const*>(std::memchr(p, '<', end - p));
+      if (!p) break;
+      ++p;
+      for (std::size_t iTag = 0; iTag < NTags; ++iTag) {
+        char const* name = TagNames[iTag];
+        char const* c = p;
+        while (*name && (c < last) && (*c == *name)) { ++c; ++name; }
+        if (*name || (c == last)) continue;
+        // the name must be complete (e.g. `<volume` is not `<volumeref`)
+        if ((*c == ' ') || (*c == '>') || (*c == '/') || (*c == '\n')
+          || (*c == '\t') || (*c == '\r'))
+        {
+          ++counts[iTag];
+          break;
+        }
+      } // for tags
+    } // while
+    return counts;
+  } // countTags()
+
+
+  /// Owner of a read-only memory mapping of a whole file.
+  class FileMap_t {
+    void* fAddress = MAP_FAILED;
+    std::size_t fSize = 0U;
+      public:
+    explicit FileMap_t(std::string const& path) {
+      int const fd = ::open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+        throw cet::exception("GDMLPreloader") << "Could not open '" << path
+          << "' for reading: " << std::strerror(errno) << "\n";
+      }
+      struct ::stat info;
+      if (::fstat(fd, &info) == 0) fSize = info.st_size;
+      if (fSize > 0U)
+        fAddress = ::mmap(nullptr, fSize, PROT_READ, MAP_PRIVATE, fd, 0);
+      ::close(fd);
+      if ((fSize > 0U) && (fAddress == MAP_FAILED)) {
+        throw cet::exception("GDMLPreloader") << "Could not map '" << path
+          << "' in memory: " << std::strerror(errno) << "\n";
+      }
+      // ask the kernel to start reading everything right away
+      if (fSize > 0U) ::madvise(fAddress, fSize, MADV_WILLNEED);
+    }
+    FileMap_t(FileMap_t const&) = delete;
+    FileMap_t& operator= (FileMap_t const&) = delete;
+    ~FileMap_t() { if (fAddress != MAP_FAILED) ::munmap(fAddress, fSize); }
+
+    char const* data() const
+      { return (fSize > 0U)? static_cast<char const*>(fAddress): nullptr; }
+    std::size_t size() const { return fSize; }
+  }; // FileMap_t
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+geo::GDMLPreloader::GDMLPreloader(std::size_t chunkSize)
+  : fChunkSize(std::max(chunkSize, std::size_t(1U)))
+  {}
+
+
+//------------------------------------------------------------------------------
+auto geo::GDMLPreloader::Preload(std::string const& path) const -> Summary_t {
+
+  FileMap_t const file { path };
+
+  Summary_t summary;
+  summary.size = file.size();
+  if (summary.size == 0U) return summary;
+
+  char const* const data = file.data();
+  char const* const last = data + summary.size;
+
+  // each task reads its own chunk, faulting its pages in concurrently;
+  // callers may hold locks, so while waiting this thread must not pick up
+  // unrelated tasks which could try to acquire them again
+  summary.nChunks = (summary.size + fChunkSize - 1) / fChunkSize;
+  std::vector<Counts_t> chunkCounts(summary.nChunks);
+  tbb::this_task_arena::isolate([&](){
+    tbb::parallel_for(std::size_t(0), summary.nChunks, [&](std::size_t iChunk){
+      char const* const begin = data + iChunk * fChunkSize;
+      char const* const end = std::min(begin + fChunkSize, last);
+      chunkCounts[iChunk] = countTags(begin, end, last);
+    });
+  });
+
+  Counts_t counts {};
+  for (Counts_t const& chunk: chunkCounts) {
+    for (std::size_t iTag = 0; iTag < NTags; ++iTag)
+      counts[iTag] += chunk[iTag];
+  }
+
+  summary.nTubes = counts[tTube];
+  summary.nVolumes = counts[tVolume];
+  summary.nPhysVols = counts[tPhysVol];
+
+  if (counts[tGDML] == 0U) return summary; // not GDML: no check
+
+  if ((counts[tSolids] == 0U) || (counts[tSolids] != counts[tSolidsEnd])
+    || (counts[tStructure] == 0U)
+    || (counts[tStructure] != counts[tStructureEnd]))
+  {
+    throw cet::exception("GDMLPreloader")
+      << "GDML file '" << path << "' (" << summary.size
+      << " bytes) is incomplete: " << counts[tSolids] << " <solids> and "
+      << counts[tSolidsEnd] << " </solids>, " << counts[tStructure]
+      << " <structure> and " << counts[tStructureEnd] << " </structure>.\n";
+  }
+
+  return summary;
+} // geo::GDMLPreloader::Preload()
+
+
+//------------------------------------------------------------------------------
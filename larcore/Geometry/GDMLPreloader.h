@@ -0,0 +1,70 @@
+/**
+ * @file   larcore/Geometry/GDMLPreloader.h
+ * @brief  Concurrent pre-reading and check of large GDML files.
+ * @see    larcore/Geometry/GDMLPreloader.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GDMLPRELOADER_H
+#define LARCORE_GEOMETRY_GDMLPRELOADER_H
+
+// C/C++ standard libraries
+#include <string>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  /**
+   * @brief Reads a GDML file concurrently ahead of its parsing by ROOT.
+   *
+   * The ROOT GDML parser reads and parses the file sequentially on a single
+   * thread, and it can't be fed with partial results; with large files
+   * (thousands of wire `<tube>` and `<physvol>` elements) on slow or remote
+   * storage, much of that time is spent waiting for the file content.
+   *
+   * `Preload()` maps the whole file in memory and scans it in chunks on
+   * concurrent TBB tasks, so that the content is brought into the page cache
+   * at the rate the storage allows with parallel requests; the following
+   * parse by ROOT then reads from memory. While scanning, the elements of the
+   * `<solids>` and `<structure>` sections are counted, and a file whose
+   * sections are not complete (e.g. truncated) is reported with an exception
+   * (`cet::exception`, category `"GDMLPreloader"`) rather than with a failure
+   * from within ROOT.
+   *
+   * Files which do not look like GDML (no `<gdml>` element) are read but not
+   * checked.
+   */
+  class GDMLPreloader {
+
+      public:
+
+    /// Default size of each chunk scanned by a task [bytes].
+    static constexpr std::size_t DefaultChunkSize = 4U << 20;
+
+    /// Information collected while reading a file.
+    struct Summary_t {
+      std::size_t size = 0U;      ///< Size of the file [bytes].
+      std::size_t nChunks = 0U;   ///< Number of chunks scanned.
+      std::size_t nTubes = 0U;    ///< Number of `<tube>` solids.
+      std::size_t nVolumes = 0U;  ///< Number of `<volume>` elements.
+      std::size_t nPhysVols = 0U; ///< Number of `<physvol>` elements.
+    }; // Summary_t
+
+
+    /// Constructor: scans files in chunks of the specified size.
+    explicit GDMLPreloader(std::size_t chunkSize = DefaultChunkSize);
+
+    /// Reads and checks the file at `path`; returns what was found in it.
+    Summary_t Preload(std::string const& path) const;
+
+
+      private:
+
+    std::size_t fChunkSize; ///< Size of each chunk [bytes].
+
+  }; // class GDMLPreloader
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GDMLPRELOADER_H
@@ -18,6 +18,14 @@
 
 // LArSoft libraries
 #include "larcorealg/Geometry/GeometryCore.h"
+#include "larcore/Geometry/GeometryCache.h"
+#include "larcore/Geometry/ChannelMapTable.h"
+#include "larcore/Geometry/ChannelMapImage.h"
+#include "larcore/Geometry/GeometrySnapshot.h"
+#include "larcore/Geometry/GeometrySnapshotCache.h"
+#include "larcore/Geometry/GeometryLoadProfiler.h"
+#include "larcore/Geometry/GeometryQueryCounters.h"
+#include "larcore/Geometry/GeometryBuilderSyntheticWires.h"
 #include "larcore/CoreUtils/ServiceUtil.h" // not used; for user's convenience
 
 // the following are included for convenience only
@@ -42,9 +50,14 @@
 #include <set>
 #include <cstring>
 #include <memory>
+#include <atomic>
+#include <mutex>
 #include <iterator> // std::forward_iterator_tag
+#include <cstdint> // std::uint64_t
 
 
+namespace art { class ModuleContext; }
+
 namespace geo {
 
   /**
@@ -70,6 +83,12 @@ namespace geo {
    * - *RelativePath* (string, default: no path): this path is prepended to the
    *   geometry file names before searching from them; the path string does not
    *   affect the file name
+   * - *ResolvedPathManifest* (string, default: empty): if not empty, path of a
+   *   file where the locations of the geometry files found in `FW_SEARCH_PATH`
+   *   are recorded, and read back by the following jobs to avoid searching
+   *   again (see geo::GeometryFileLocator); the file is shared by `Geometry`
+   *   and `AuxDetGeometry`, and searches are remembered within the process
+   *   even without a manifest
    * - *GDML* (string, mandatory): path of the GDML file to be served to Geant4
    *   for detector simulation. The full file is composed out of the optional
    *   relative path specified by `RelativePath` path and the base name
@@ -97,42 +116,481 @@ namespace geo {
    *   is directly passed to the channel mapping algorithm (see
    *   geo::ChannelMapAlg); its content is dependent on the chosen
    *   implementation of `geo::ChannelMapAlg`
+   * - *ChannelMapping* (a parameter set; default: empty): if not empty, it is
+   *   the configuration of an art tool implementing `geo::ChannelMapSetupTool`
+   *   (selected by its `tool_type` parameter), which creates the channel
+   *   mapping algorithm instead of the `geo::ExptGeoHelperInterface` service;
+   *   a new tool is created for each loaded geometry, and it is configured
+   *   only by this parameter set (`SortingParameters` is not used)
    * - *Builder* (a parameter set: default: empty): configuration for the
    *   geometry builder; if omitted, the standard builder
    *   (`geo::GeometryBuilderStandard`) with standard configuration will be
    *   used; if specified, currently the standard builder is nevertheless used;
    *   this interface can be "toolized", in which case this parameter set will
    *   select and configure the chosen tool.
+   * - *SyntheticWires* (a parameter set; default: empty): if its `Planes`
+   *   list is not empty, the ROOT geometry is loaded from the `_nowires`
+   *   version of the GDML file (as for `DisableWiresInG4`), and the wires of
+   *   the listed plane volumes are created from their layout instead of from
+   *   wire volumes (see geo::GeometryBuilderSyntheticWires); this saves the
+   *   memory and the navigation cost of the wire volumes in ROOT. Each entry
+   *   of `Planes` describes the wires of all the planes with volume name
+   *   `Volume` (string): `Pitch` (real, [cm]), `Angle` (real, [degrees]) of
+   *   the wires from the local _z_ axis toward the local _y_ axis,
+   *   `WireRadius` (real, [cm]) and `Offset` (real, default: `Pitch`) of the
+   *   first wire from the plane corner [cm]; the layout is ideal, so wires
+   *   will differ from the ones in a GDML file whose wires were placed or
+   *   trimmed differently. Snapshots of ROOT geometry (`UseGeometryCache`)
+   *   are read but not written in this mode; `geo::AuxDetGeometry` must be
+   *   configured with the same `_nowires` file, since the two services
+   *   share the ROOT geometry (see geo::GeometrySourceRegistry)
+   * - *UseGeometryCache* (boolean, default: false): if true, the ROOT geometry
+   *   is loaded from a binary snapshot of the geometry description when one
+   *   is available, instead of parsing the GDML file (see geo::GeometryCache);
+   *   snapshots are identified by the content of the geometry file only, so
+   *   that jobs with different `Builder`, `SortingParameters` or
+   *   `ChannelMapping` configuration share them
+   * - *GeometryCacheDirectory* (string, default: empty): directory where
+   *   geometry snapshots are looked for and stored; if empty, the snapshots
+   *   are kept in the same directory as the geometry description file
+   * - *UpdateGeometryCache* (boolean, default: true): if a snapshot is not
+   *   available, it is created after the geometry description is parsed
+   * - *BuildChannelMapTable* (boolean, default: false): if true, after each
+   *   geometry is loaded the channel mapping is precomputed into flat lookup
+   *   tables, available via `ChannelTable()`
+   * - *BuildWireGeometryTable* (boolean, default: false): if true, after each
+   *   geometry is loaded the geometry of all the wires is copied into flat
+   *   arrays, available via `WireTable()` together with batch computation of
+   *   wire crossings (see geo::WireGeometryTable)
+   * - *SharedChannelMapDirectory* (string, default: empty): if not empty and
+   *   `BuildChannelMapTable` is set, the channel mapping tables are shared with
+   *   the other processes using the same geometry through a memory-mapped
+   *   image file in this directory (a memory-backed directory like `/dev/shm`
+   *   is recommended); the first process builds the tables and publishes the
+   *   image, the following ones map it (see geo::ChannelMapImage); images are
+   *   identified by the content of the geometry file, by the `Builder`,
+   *   `SortingParameters` and `ChannelMapping` configuration and by the
+   *   implementation and configuration of the `geo::ExptGeoHelperInterface`
+   *   service, so a persistent directory works as an on-disk cache of the
+   *   tables for all the following jobs; only the channel mapping tables are
+   *   shared, while the ROOT geometry and the geometry objects, made of
+   *   pointers into the process memory, are still built by each process:
+   *   this option saves the time to build the tables, but does not reduce
+   *   the geometry memory of each process
+   * - *ParallelInitialization* (boolean, default: false): if true, independent
+   *   steps of the geometry loading are run concurrently: the searches of the
+   *   GDML and ROOT files (including the snapshot key computation when
+   *   `UseGeometryCache` is set), and the filling of the channel mapping
+   *   tables; the loading of the ROOT geometry itself is always sequential,
+   *   since ROOT keeps it in the global `gGeoManager`
+   * - *PreloadGDML* (boolean, default: false): if true, before ROOT parses
+   *   a GDML file, the file is read into memory and checked for completeness
+   *   by concurrent tasks (see geo::GDMLPreloader), so that the sequential
+   *   parse does not wait for the storage; useful for large descriptions
+   *   (with many wires) on slow or remote file systems
+   * - *LazyLoading* (boolean, default: false): if true, on construction the
+   *   geometry files are only located, and the geometry is actually loaded
+   *   on the first request of the service provider via `provider()` (e.g. via
+   *   `lar::providerFrom<geo::Geometry>()`); see below
+   * - *LazyLoadingIgnoredModules* (list of strings, default: empty): labels
+   *   of the modules which never use the geometry; in lazy mode, their
+   *   construction does not cause the geometry to be loaded (see below)
+   * - *GeometryHistorySize* (unsigned integer, default: 2): number of recently
+   *   loaded geometries whose precomputed information (`Snapshot()`) is kept;
+   *   when the geometry changes back to one of them (e.g. in input files
+   *   alternating detector configurations), that information is reused
+   *   instead of being computed again; `0` disables this cache
+   * - *ProfileLoading* (boolean, default: false): if true, the time spent in
+   *   each step of the geometry loading (files search, geometry description
+   *   loading, channel mapping configuration and application, precomputed
+   *   information) and the peak memory usage after it are reported via
+   *   message facility (category `GeometryProfile`), together with a summary
+   *   table at the end of the job (see geo::GeometryLoadProfiler)
+   * - *CountQueries* (boolean, default: false): if true, the calls to the
+   *   most common queries (channel mapping, point location, ID iterations,
+   *   optical channels) are counted for each module, and a table of them is
+   *   reported at the end of the job via message facility (category
+   *   `GeometryQueries`; see geo::GeometryQueryCounters); only the calls
+   *   through `geo::Geometry` are counted, not the ones through the
+   *   `geo::GeometryCore` provider (e.g. from `lar::providerFrom()`), and
+   *   the calls from tasks spawned by a module are attributed to no module
+   * - *QuerySamplingPeriod* (unsigned integer, default: 0): if not `0`, one
+   *   counted query every this many on each thread is also timed
+   *
+   * When the ROOT geometry is loaded from a snapshot, `ROOTFile()` reports the
+   * path of the snapshot file.
    *
    * @note Currently, the file defined by `GDML` parameter is also served to
    * ROOT for the internal geometry representation.
    *
+   * Lazy loading
+   * -------------
+   *
+   * In lazy loading mode (`LazyLoading`), the geometry description is loaded
+   * only when the provider is first asked for via `provider()` or when the
+   * channel mapping tables are requested via `ChannelTable()`.
+   * The loading is thread-safe: concurrent first requests wait for a single
+   * loading to complete.
+   * Since `geo::Geometry` is itself the provider, code accessing the
+   * geometry directly through `art::ServiceHandle<geo::Geometry>` would
+   * bypass this mechanism. For this reason, the geometry is also loaded
+   * before the construction of the first module (so before any module code
+   * runs), unless that module is listed in `LazyLoadingIgnoredModules` or is
+   * a framework module not using the geometry (like `RootOutput`): the
+   * loading is deferred only in jobs where all the modules are known not to
+   * use the geometry, or to reach it only via `provider()`, and no module can
+   * find an empty geometry. Other services must access the geometry via
+   * `provider()` (e.g. `lar::providerFrom<geo::Geometry>()`).
+   * Loading triggered by a new run (see `ForceUseFCLOnly`) is also deferred
+   * if the geometry has not been used yet.
+   *
+   * Geometry reloading
+   * -------------------
+   *
+   * The information that this service derives from each loaded geometry
+   * (the channel mapping tables, the wire geometry table, the flat arrays of
+   * IDs, the map of the optical channels and the spatial index of the
+   * volumes) is collected into
+   * an immutable `geo::GeometrySnapshot`. When a new geometry is loaded (for
+   * example on a new run), a complete new snapshot is built aside and then
+   * published by atomically replacing the previous one; code on other threads
+   * holding the old snapshot (from `Snapshot()`) keeps it valid until it
+   * releases it.
+   * Loading of geometries is serialized.
+   * Each published snapshot is tagged by a "generation" number
+   * (`Generation()`), which increases each time a geometry is loaded, and
+   * which downstream caches can use to cheaply detect geometry changes.
+   * Loading a geometry also invalidates the providers cached by
+   * `lar::cachedProviderFrom()`.
+   *
+   * The geometry description itself (`geo::GeometryCore`) is instead still
+   * updated in place: ROOT supports a single geometry per process
+   * (`gGeoManager`), so two complete descriptions can't coexist. This update
+   * happens only on `sPreBeginRun`, when art has no event in flight on any
+   * schedule, so it is safe to use this service with multiple schedules as
+   * long as geometry information is not cached across runs.
+   *
+   * The ROOT geometry is shared with `geo::AuxDetGeometry`: it is imported
+   * only if it has not been already loaded from the same file by any of the
+   * two services. When the other service imports a different file (e.g. for
+   * a new detector), this service loads its geometry again at the beginning
+   * of the run (see `geo::GeometrySourceRegistry`).
+   *
    */
   class Geometry: public GeometryCore
   {
   public:
 
     using provider_type = GeometryCore; ///< type of service provider
+    using Queries_t = geo::GeometryQueryCounters; ///< query statistics type
 
     Geometry(fhicl::ParameterSet const& pset, art::ActivityRegistry& reg);
 
     /// Returns a pointer to the geometry service provider
     provider_type const* provider() const
-      { return static_cast<provider_type const*>(this); }
+      { EnsureLoaded(); return static_cast<provider_type const*>(this); }
+
+    /**
+     * @brief Returns the information precomputed for the current geometry.
+     * @return a shared pointer to the current snapshot (never `nullptr`)
+     *
+     * The returned snapshot stays valid for as long as the pointer is kept,
+     * even after a new geometry is loaded.
+     * This function is thread-safe.
+     */
+    std::shared_ptr<geo::GeometrySnapshot const> Snapshot() const
+      { EnsureLoaded(); return std::atomic_load(&fSnapshot); }
+
+    /**
+     * @brief Returns the precomputed channel mapping tables.
+     * @return a pointer to the tables, `nullptr` if not configured
+     *
+     * The tables answer the most common channel mapping queries
+     * (`ChannelToWire()`, `PlaneWireToChannel()`) without going through the
+     * virtual interface of the channel mapping algorithm.
+     * They are available only if `BuildChannelMapTable` is set, and they are
+     * rebuilt every time a new geometry is loaded: the pointer should not be
+     * kept across runs (keep the whole `Snapshot()` instead).
+     */
+    geo::ChannelMapTable const* ChannelTable() const
+      { return Snapshot()->ChannelTable(); }
+
+    /**
+     * @brief Returns the precomputed wire geometry table.
+     * @return a pointer to the table, `nullptr` if not configured
+     *
+     * The table is available only if `BuildWireGeometryTable` is set; as for
+     * `ChannelTable()`, the pointer should not be kept across runs.
+     */
+    geo::WireGeometryTable const* WireTable() const
+      { return Snapshot()->WireTable(); }
+
+    /**
+     * @brief Returns the flat arrays of all the geometry IDs and channels.
+     * @return a pointer to the table, always available
+     * @see geo::GeometryIDTable
+     *
+     * The arrays allow loops on all the wires (or planes, TPC...) without the
+     * overhead of the geometry iterators. As for `ChannelTable()`, the
+     * pointer should not be kept across runs.
+     */
+    geo::GeometryIDTable const* IDTable() const
+      {
+        auto const probe = countQuery(Queries_t::qIteration);
+        return Snapshot()->IDTable();
+      }
+
+    /**
+     * @brief Returns the generation number of the current geometry.
+     *
+     * The number increases every time a geometry is loaded (even if it is
+     * the same as an earlier one), so that a change of the number means that
+     * everything derived from the geometry should be recomputed.
+     * This function is thread-safe.
+     */
+    std::uint64_t Generation() const
+      { EnsureLoaded(); return fGeneration.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Returns the optical detector serving the specified channel.
+     * @param opChannel the optical channel
+     * @return a pointer to the optical detector, `nullptr` if none
+     * @see `geo::GeometryCore::OpDetGeoFromOpChannel()`
+     *
+     * Differently from `OpDetGeoFromOpChannel()`, invalid channels do not
+     * cause an exception. The answer comes from a precomputed map
+     * (`geo::OpticalChannelIndex`); loops on many channels should rather
+     * get that map once from `Snapshot()` and query it directly.
+     */
+    geo::OpDetGeo const* FindOpDetGeoFromOpChannel(unsigned int opChannel) const
+      {
+        auto const probe = countQuery(Queries_t::qOpChannel);
+        auto const snapshot = Snapshot();
+        return
+          snapshot->OpChannelIndex()->OpDetGeoFromOpChannel(*this, opChannel);
+      }
+
+    /**
+     * @brief Returns the ID of the TPC containing `point`.
+     * @param point the point to be located [cm]
+     * @return the ID of the TPC, invalid if no TPC contains `point`
+     * @see `geo::GeometryCore::PositionToTPCID()`
+     *
+     * The answer is the same as `PositionToTPCID()`, but it is found with a
+     * spatial index (`geo::GeometrySpatialIndex`) rather than testing all
+     * the TPC in turn.
+     */
+    geo::TPCID IndexedPositionToTPCID(geo::Point_t const& point) const
+      {
+        auto const probe = countQuery(Queries_t::qIndexedPosition);
+        auto const snapshot = Snapshot();
+        return snapshot->SpatialIndex()
+          ->PositionToTPCID(*this, point, 1.0 + DefaultWiggle());
+      }
+
+    /**
+     * @brief Returns the ID of the cryostat containing `point`.
+     * @param point the point to be located [cm]
+     * @return the ID of the cryostat, invalid if none contains `point`
+     * @see `geo::GeometryCore::PositionToCryostatID()`,
+     *      `IndexedPositionToTPCID()`
+     */
+    geo::CryostatID IndexedPositionToCryostatID(geo::Point_t const& point) const
+      {
+        auto const probe = countQuery(Queries_t::qIndexedPosition);
+        auto const snapshot = Snapshot();
+        return snapshot->SpatialIndex()
+          ->PositionToCryostatID(*this, point, 1.0 + DefaultWiggle());
+      }
+
+    /**
+     * @brief Returns the channel mapping algorithm as its concrete type.
+     * @tparam ChannelMap the expected type of channel mapping algorithm
+     * @return the channel mapping, `nullptr` if not of type `ChannelMap`
+     *
+     * Calls via the concrete type of the channel mapping can be resolved at
+     * compile time and inlined, while calls through `geo::GeometryCore` go
+     * through the virtual interface of `geo::ChannelMapAlg`.
+     * For example, see `geo::RegularChannelMapAlg`.
+     * The channel mapping is replaced when a new geometry is loaded: the
+     * pointer should not be kept across runs.
+     */
+    template <typename ChannelMap>
+    ChannelMap const* ChannelMapAs() const
+      {
+        EnsureLoaded();
+        return dynamic_cast<ChannelMap const*>(fChannelMapAlg);
+      }
+
+    /// Returns the statistics of the geometry loading (see `ProfileLoading`).
+    geo::GeometryLoadProfiler const& LoadingProfile() const
+      { return fProfiler; }
+
+    /// Returns the statistics of the queries (`nullptr` if not counting).
+    Queries_t const* QueryCounters() const { return fQueryCounters.get(); }
+
+
+    /// @{
+    /**
+     * @name Counted queries
+     *
+     * These are the same as the `geo::GeometryCore` ones, and they are
+     * recorded in the query statistics if `CountQueries` is set.
+     * As the other queries of this service, they first load the pending
+     * geometry, if any.
+     */
+
+    /// @see `geo::GeometryCore::ChannelToWire()`
+    std::vector<geo::WireID> ChannelToWire(raw::ChannelID_t const channel) const
+      {
+        EnsureLoaded();
+        auto const probe = countQuery(Queries_t::qChannelToWire);
+        return GeometryCore::ChannelToWire(channel);
+      }
+
+    using GeometryCore::PlaneWireToChannel;
+
+    /// @see `geo::GeometryCore::PlaneWireToChannel()`
+    raw::ChannelID_t PlaneWireToChannel(geo::WireID const& wireID) const
+      {
+        EnsureLoaded();
+        auto const probe = countQuery(Queries_t::qPlaneWireToChannel);
+        return GeometryCore::PlaneWireToChannel(wireID);
+      }
+
+    using GeometryCore::PositionToTPCID;
+
+    /// @see `geo::GeometryCore::PositionToTPCID()`
+    geo::TPCID PositionToTPCID(geo::Point_t const& point) const
+      {
+        EnsureLoaded();
+        auto const probe = countQuery(Queries_t::qPositionToTPCID);
+        return GeometryCore::PositionToTPCID(point);
+      }
+
+    /// @see `geo::GeometryCore::OpDetGeoFromOpChannel()`
+    geo::OpDetGeo const& OpDetGeoFromOpChannel(unsigned int opChannel) const
+      {
+        EnsureLoaded();
+        auto const probe = countQuery(Queries_t::qOpChannel);
+        return GeometryCore::OpDetGeoFromOpChannel(opChannel);
+      }
+
+    using GeometryCore::IterateTPCIDs;
+    using GeometryCore::IteratePlaneIDs;
+    using GeometryCore::IterateWireIDs;
+
+    /// @see `geo::GeometryCore::IterateTPCIDs()`
+    decltype(auto) IterateTPCIDs() const
+      {
+        EnsureLoaded();
+        auto const probe = countQuery(Queries_t::qIteration);
+        return GeometryCore::IterateTPCIDs();
+      }
+
+    /// @see `geo::GeometryCore::IteratePlaneIDs()`
+    decltype(auto) IteratePlaneIDs() const
+      {
+        EnsureLoaded();
+        auto const probe = countQuery(Queries_t::qIteration);
+        return GeometryCore::IteratePlaneIDs();
+      }
+
+    /// @see `geo::GeometryCore::IterateWireIDs()`
+    decltype(auto) IterateWireIDs() const
+      {
+        EnsureLoaded();
+        auto const probe = countQuery(Queries_t::qIteration);
+        return GeometryCore::IterateWireIDs();
+      }
+
+    /// @}
 
   private:
 
+    /// Full paths of the files describing a geometry.
+    struct GeometryFiles_t {
+      std::string GDMLfile;     ///< File for Geant4.
+      std::string ROOTfile;     ///< File for ROOT geometry.
+      std::string descriptionKey; ///< Key of the ROOT geometry (snapshots).
+      std::string cacheKey;     ///< Key of geometry and configuration (images).
+      std::string snapshotFile; ///< Snapshot to be loaded (if any).
+    }; // GeometryFiles_t
+
     /// Updates the geometry if needed at the beginning of each new run
     void preBeginRun(art::Run const& run);
 
+    /// Loads the geometry of the detector of `run`; returns if it did.
+    bool LoadRunGeometry(art::Run const& run);
+
+    /// Rebuilds the geometry if another service replaced its ROOT geometry.
+    void ReloadIfStale();
+
+    /// Reports the loading profile and query summaries at the end of the job.
+    void postEndJob();
+
+    /// In lazy mode, loads the geometry before a module which may use it.
+    void preModuleConstruction(art::ModuleDescription const& module);
+
+    /// Attributes the following geometry queries to the starting module.
+    void preModule(art::ModuleContext const& context);
+
+    /// Attributes the geometry queries back to the module interrupted, if any.
+    void postModule(art::ModuleContext const&);
+
+    /// Records a query (if counting); the returned object may time it.
+    Queries_t::Probe countQuery(Queries_t::Query_t query) const
+      {
+        return fQueryCounters
+          ? fQueryCounters->Count(query): Queries_t::Probe{};
+      }
+
     /// Expands the provided paths and loads the geometry description(s)
-    void LoadNewGeometry(
-      std::string gdmlfile, std::string rootfile,
-      bool bForceReload = false
-      );
+    void LoadNewGeometry(std::string gdmlfile, std::string rootfile);
+
+    /// Expands the provided path and finds the geometry files.
+    GeometryFiles_t LocateGeometryFiles(std::string const& gdmlfile) const;
+
+    /**
+     * @brief Loads the geometry description from the specified files.
+     *
+     * The ROOT geometry is imported only if it is not already loaded from
+     * the same file, possibly by another service
+     * (see geo::GeometrySourceRegistry).
+     *
+     * The geometry description is not built again if the same files are
+     * loaded, as when the new detector name shares the geometry file of the
+     * previous one. The channel mapping, which depends on the detector name,
+     * is always applied again.
+     */
+    void LoadGeometryFiles(GeometryFiles_t const& files);
+
+    /// Reads and checks the GDML file at `path` ahead of ROOT parsing it.
+    void PreloadGeometryFile(std::string const& path) const;
+
+    /// Loads the pending geometry, if any (thread-safe).
+    void EnsureLoaded() const;
+
+    /// Creates the channel mapping tables for the current geometry.
+    std::unique_ptr<geo::ChannelMapTable const> MakeChannelMapTable() const;
+
+    /// Creates the snapshot of the current geometry.
+    std::shared_ptr<geo::GeometrySnapshot const> MakeSnapshot() const;
+
+    /// Returns the key identifying the snapshot of the specified geometry.
+    std::string SnapshotKey(GeometryFiles_t const& files) const;
+
+    /// Returns the key identifying the input of the geometry description.
+    std::string DescriptionKey(GeometryFiles_t const& files) const;
+
+    /// Returns the key of the geometry helper creating the channel mapping.
+    std::string ChannelMapSourceKey() const;
 
     void InitializeChannelMap();
 
+    /// Creates the channel mapping algorithm for the current geometry.
+    std::unique_ptr<geo::ChannelMapAlg> MakeChannelMapAlg() const;
+
     std::string               fRelPath;          ///< Relative path added to FW_SEARCH_PATH to search for
                                                  ///< geometry file
     bool                      fDisableWiresInG4; ///< If set true, supply G4 with GDMLfileNoWires
@@ -141,6 +599,54 @@ namespace geo {
                                                  ///< files specified in the fcl file
     fhicl::ParameterSet       fSortingParameters;///< Parameter set to define the channel map sorting
     fhicl::ParameterSet       fBuilderParameters;///< Parameter set for geometry builder.
+    fhicl::ParameterSet       fChannelMappingConfig; ///< Channel mapping tool configuration.
+    fhicl::ParameterSet       fSyntheticWiresConfig; ///< Wire synthesis configuration.
+
+    /// Layouts of the planes whose wires are synthesized (none if empty).
+    std::vector<geo::GeometryBuilderSyntheticWires::PlaneLayout_t>
+                              fSyntheticWirePlanes;
+
+    bool                      fBuildChannelMapTable; ///< Whether to precompute channel tables.
+    bool                      fBuildWireGeometryTable; ///< Whether to precompute wire arrays.
+    bool                      fParallelInitialization; ///< Whether to run loading steps concurrently.
+    bool                      fPreloadGDML; ///< Whether to read GDML files ahead of ROOT.
+
+    std::unique_ptr<geo::GeometryCache> fGeometryCache; ///< Snapshot cache (if enabled).
+
+    /// Channel mapping in use (owned by `geo::GeometryCore`).
+    geo::ChannelMapAlg const* fChannelMapAlg = nullptr;
+
+    /// Information precomputed for the current geometry (atomic access only).
+    std::shared_ptr<geo::GeometrySnapshot const> fSnapshot;
+
+    /// Snapshots of the recently loaded geometries.
+    geo::GeometrySnapshotCache fSnapshotCache;
+
+    /// Number of geometries loaded so far.
+    std::atomic<std::uint64_t> fGeneration { 0U };
+
+    /// Shared image of the channel mapping tables (if enabled).
+    std::unique_ptr<geo::ChannelMapImage> fChannelMapImage;
+
+    GeometryFiles_t           fCurrentGeometry; ///< Files of the loaded geometry.
+
+    /// Input of the loaded geometry description (empty if none).
+    std::string               fLoadedDescription;
+
+    bool                      fLazyLoading; ///< Whether to defer geometry loading.
+
+    /// Labels of the modules not triggering the lazy loading.
+    std::set<std::string>     fLazyLoadingIgnoredModules;
+
+    /// Geometry waiting to be loaded in lazy mode.
+    GeometryFiles_t           fPendingGeometry;
+    mutable std::atomic<bool> fLoaded { false }; ///< Whether pending geometry is loaded.
+    mutable std::mutex        fLoadMutex; ///< Serializes the geometry loading.
+
+    geo::GeometryLoadProfiler fProfiler; ///< Statistics of the loading steps.
+
+    /// Statistics of the queries (if enabled).
+    std::unique_ptr<geo::GeometryQueryCounters> fQueryCounters;
   };
 
 } // namespace geo
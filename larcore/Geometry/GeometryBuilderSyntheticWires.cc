@@ -0,0 +1,215 @@
+/**
+ * @file   larcore/Geometry/GeometryBuilderSyntheticWires.cc
+ * @brief  Geometry builder creating the wires of planes without wire volumes.
+ * @see    larcore/Geometry/GeometryBuilderSyntheticWires.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometryBuilderSyntheticWires.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/WireGeo.h"
+#include "larcorealg/Geometry/TransformationMatrix.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// ROOT libraries
+#include "TGeoBBox.h"
+#include "TGeoManager.h"
+#include "TGeoNode.h"
+#include "TGeoTube.h"
+#include "TGeoVolume.h"
+#include "Math/GenVector/RotationX.h"
+#include "Math/GenVector/Translation3D.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max()
+#include <cmath> // std::sin(), std::cos(), std::abs(), std::floor()
+#include <limits>
+#include <utility> // std::move()
+
+
+//------------------------------------------------------------------------------
+geo::GeometryBuilderSyntheticWires::GeometryBuilderSyntheticWires(
+  geo::GeometryBuilderStandard::Config const& config,
+  std::vector<PlaneLayout_t> layouts
+  )
+  : geo::GeometryBuilderStandard(config)
+{
+  for (PlaneLayout_t& layout: layouts) {
+    if (layout.pitch <= 0.0) {
+      throw cet::exception("GeometryBuilderSyntheticWires")
+        << "Wire pitch of plane volume '" << layout.volumeName
+        << "' must be positive (" << layout.pitch << " cm).\n";
+    }
+    std::string const name = layout.volumeName;
+    fLayouts.emplace(name, std::move(layout));
+  } // for
+} // geo::GeometryBuilderSyntheticWires::GeometryBuilderSyntheticWires()
+
+
+//------------------------------------------------------------------------------
+auto geo::GeometryBuilderSyntheticWires::ComputeWires
+  (PlaneLayout_t const& layout, double halfY, double halfZ)
+  -> std::vector<WireLayout_t>
+{
+  // wire direction is (sinA, cosA), pitch direction (cosA, -sinA) in (y, z)
+  double const sinA = std::sin(layout.angle), cosA = std::cos(layout.angle);
+
+  // the plane extends within [ -extent, extent ] along the pitch direction
+  double const extent = std::abs(cosA) * halfY + std::abs(sinA) * halfZ;
+  double const span = 2.0 * (extent - layout.offset);
+  if (span < 0.0) return {};
+  auto const nWires = static_cast<std::size_t>
+    (std::floor(span / layout.pitch + 1e-9)) + 1U;
+
+  // range of positions along the wire direction within [ -half, half ]
+  // on a direction whose component is `dir`, for a wire starting at `start`
+  auto const clip = [](double& tMin, double& tMax,
+    double start, double dir, double half)
+    {
+      if (std::abs(dir) < 1e-12) return;
+      double const t1 = (-half - start) / dir, t2 = (half - start) / dir;
+      tMin = std::max(tMin, std::min(t1, t2));
+      tMax = std::min(tMax, std::max(t1, t2));
+    };
+
+  std::vector<WireLayout_t> wires;
+  wires.reserve(nWires);
+  for (std::size_t iWire = 0; iWire < nWires; ++iWire) {
+    double const s = -extent + layout.offset + iWire * layout.pitch;
+    double const y0 = s * cosA, z0 = -s * sinA; // closest point to center
+
+    double tMin = -std::numeric_limits<double>::max();
+    double tMax = std::numeric_limits<double>::max();
+    clip(tMin, tMax, y0, sinA, halfY);
+    clip(tMin, tMax, z0, cosA, halfZ);
+    if (tMax <= tMin) continue;
+
+    double const t = (tMin + tMax) / 2.0;
+    wires.push_back({ y0 + t * sinA, z0 + t * cosA, (tMax - tMin) / 2.0 });
+  } // for wires
+
+  return wires;
+} // geo::GeometryBuilderSyntheticWires::ComputeWires()
+
+
+//------------------------------------------------------------------------------
+auto geo::GeometryBuilderSyntheticWires::doExtractWires(Path_t& path)
+  -> Wires_t
+{
+  Wires_t wires = geo::GeometryBuilderStandard::doExtractWires(path);
+  if (!wires.empty()) return wires;
+
+  auto const iLayout = fLayouts.find(path.current().GetVolume()->GetName());
+  if (iLayout == fLayouts.end()) return wires;
+
+  return makeWires(path, iLayout->second);
+} // geo::GeometryBuilderSyntheticWires::doExtractWires()
+
+
+//------------------------------------------------------------------------------
+auto geo::GeometryBuilderSyntheticWires::makeWires
+  (Path_t const& path, PlaneLayout_t const& layout) -> Wires_t
+{
+  TGeoVolume const& planeVolume = *(path.current().GetVolume());
+  auto const* box = dynamic_cast<TGeoBBox const*>(planeVolume.GetShape());
+  if (!box || (box->GetDX() > box->GetDY()) || (box->GetDX() > box->GetDZ()))
+  {
+    throw cet::exception("GeometryBuilderSyntheticWires")
+      << "Plane volume '" << planeVolume.GetName()
+      << "' must be a box thin along its x axis to host synthetic wires.\n";
+  }
+
+  if (!fContainer) fContainer = findOrCreateContainer();
+
+  auto const planeTrans
+    = path.currentTransformation<geo::TransformationMatrix>();
+  ROOT::Math::RotationX const wireRotation { -layout.angle };
+
+  Wires_t wires;
+  for (WireLayout_t const& wire
+    : ComputeWires(layout, box->GetDY(), box->GetDZ()))
+  {
+    // wires with the same length (within 1 nm) share the same volume
+    auto const volumeKey = std::make_pair
+      (layout.volumeName, static_cast<long long>(wire.halfLength * 1e7));
+    TGeoVolume*& volume = fWireVolumes[volumeKey];
+    if (!volume) volume = findOrCreateWireVolume(layout, wire, planeVolume);
+
+    TGeoNode const& node = nextWireNode(*volume);
+
+    geo::TransformationMatrix const wireTrans
+      { wireRotation, ROOT::Math::Translation3D(0.0, wire.y, wire.z) };
+    wires.emplace_back(node, planeTrans * wireTrans);
+  } // for wires
+
+  return wires;
+} // geo::GeometryBuilderSyntheticWires::makeWires()
+
+
+//------------------------------------------------------------------------------
+TGeoVolumeAssembly* geo::GeometryBuilderSyntheticWires::findOrCreateContainer()
+{
+  // a description built again on the same ROOT geometry finds the container
+  // created the first time, instead of adding one more to the geometry
+  if (gGeoManager) {
+    if (auto* container = dynamic_cast<TGeoVolumeAssembly*>
+      (gGeoManager->GetVolume(ContainerName)))
+    {
+      return container;
+    }
+  }
+  return new TGeoVolumeAssembly(ContainerName);
+} // geo::GeometryBuilderSyntheticWires::findOrCreateContainer()
+
+
+//------------------------------------------------------------------------------
+TGeoVolume* geo::GeometryBuilderSyntheticWires::findOrCreateWireVolume(
+  PlaneLayout_t const& layout, WireLayout_t const& wire,
+  TGeoVolume const& planeVolume
+) {
+  // the name identifies plane and length (in nm), so that rebuilding finds
+  // the volume created the first time
+  std::string const name = "volSyntheticWire_" + layout.volumeName + '_'
+    + std::to_string(static_cast<long long>(wire.halfLength * 1e7));
+
+  if (gGeoManager) {
+    TGeoVolume* const volume = gGeoManager->GetVolume(name.c_str());
+    auto const* tube
+      = volume? dynamic_cast<TGeoTube const*>(volume->GetShape()): nullptr;
+    if (tube && (std::abs(tube->GetRmax() - layout.wireRadius) < 1e-7)
+      && (volume->GetMedium() == planeVolume.GetMedium()))
+    {
+      return volume;
+    }
+  } // if geometry manager
+
+  return new TGeoVolume(
+    name.c_str(),
+    new TGeoTube(0.0, layout.wireRadius, wire.halfLength),
+    planeVolume.GetMedium()
+    );
+} // geo::GeometryBuilderSyntheticWires::findOrCreateWireVolume()
+
+
+//------------------------------------------------------------------------------
+TGeoNode const& geo::GeometryBuilderSyntheticWires::nextWireNode
+  (TGeoVolume& volume)
+{
+  // the nodes are owned by the container, which is not in the volume tree;
+  // when the description is built again, the wires come in the same order
+  // and the nodes of the previous building are reused
+  int const iNode = fUsedNodes++;
+  if (iNode < fContainer->GetNdaughters()) {
+    TGeoNode const* node = fContainer->GetNode(iNode);
+    if (node->GetVolume() == &volume) return *node;
+    fUsedNodes = fContainer->GetNdaughters() + 1; // no more reuse
+  }
+  fContainer->AddNode(&volume, fContainer->GetNdaughters());
+  return *(fContainer->GetNode(fContainer->GetNdaughters() - 1));
+} // geo::GeometryBuilderSyntheticWires::nextWireNode()
+
+
+//------------------------------------------------------------------------------
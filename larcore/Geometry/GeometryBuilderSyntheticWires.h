@@ -0,0 +1,139 @@
+/**
+ * @file   larcore/Geometry/GeometryBuilderSyntheticWires.h
+ * @brief  Geometry builder creating the wires of planes without wire volumes.
+ * @see    larcore/Geometry/GeometryBuilderSyntheticWires.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYBUILDERSYNTHETICWIRES_H
+#define LARCORE_GEOMETRY_GEOMETRYBUILDERSYNTHETICWIRES_H
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryBuilderStandard.h"
+
+// C/C++ standard libraries
+#include <map>
+#include <string>
+#include <utility> // std::pair<>
+#include <vector>
+
+
+// ROOT libraries
+class TGeoNode;
+class TGeoVolume;
+class TGeoVolumeAssembly;
+
+
+namespace geo {
+
+  /**
+   * @brief Geometry builder creating wires from the layout of their plane.
+   *
+   * This builder behaves like `geo::GeometryBuilderStandard`, except for the
+   * wire planes which have no wire volume in the geometry description (like
+   * in the `_nowires` GDML files used for Geant4): if the volume of one of
+   * these planes has a layout configured (`PlaneLayout_t`), its wires are
+   * created from it, filling the whole plane with parallel wires with the
+   * configured pitch and direction.
+   *
+   * The plane must be a box, thin along its local _x_ axis; wires lie on
+   * its _y_ _z_ middle plane. Starting at `offset` from one corner of the
+   * plane, wires are placed one `pitch` apart, until they get closer than
+   * `offset` to the opposite corner; each wire spans the whole plane.
+   * The order of the produced wires does not matter, since wires are sorted
+   * afterwards by the geometry.
+   *
+   * The ROOT volumes of the created wires are not part of the detector
+   * volume tree, so that the ROOT navigation does not see them: they are
+   * daughters of an assembly volume (`volSyntheticWires`) which is not placed
+   * anywhere. Wires of the same length and radius share the same volume.
+   * The volumes are owned by the ROOT geometry manager current at the time
+   * of the building, and they are discarded together with it. A description
+   * built again on the same ROOT geometry reuses the assembly, the wire
+   * volumes and their nodes already there, rather than adding new ones.
+   */
+  class GeometryBuilderSyntheticWires: public geo::GeometryBuilderStandard {
+
+      public:
+
+    /// Layout of the wires of a plane.
+    struct PlaneLayout_t {
+      std::string volumeName; ///< Name of the plane volume.
+      double pitch = 0.0;  ///< Distance between wires [cm].
+      double angle = 0.0;  ///< Angle of wires from _z_ toward _y_ [rad].
+      double offset = 0.0; ///< Distance of the first wire from the corner [cm].
+      double wireRadius = 0.0; ///< Radius of the wires [cm].
+    }; // PlaneLayout_t
+
+    /// Position of a wire in the frame of its plane.
+    struct WireLayout_t {
+      double y = 0.0; ///< Local _y_ coordinate of the center [cm].
+      double z = 0.0; ///< Local _z_ coordinate of the center [cm].
+      double halfLength = 0.0; ///< Half length of the wire [cm].
+    }; // WireLayout_t
+
+
+    /**
+     * @brief Constructor.
+     * @param config configuration of the standard builder
+     * @param layouts layout of the wires of the planes to be created
+     */
+    GeometryBuilderSyntheticWires(
+      geo::GeometryBuilderStandard::Config const& config,
+      std::vector<PlaneLayout_t> layouts
+      );
+
+    /**
+     * @brief Returns the wires of a plane with the specified layout.
+     * @param layout layout of the wires
+     * @param halfY half size of the plane along its local _y_ axis [cm]
+     * @param halfZ half size of the plane along its local _z_ axis [cm]
+     * @return the position and size of all the wires of the plane
+     */
+    static std::vector<WireLayout_t> ComputeWires
+      (PlaneLayout_t const& layout, double halfY, double halfZ);
+
+
+      protected:
+
+    /// Returns the wires under `path`, created if the plane has none.
+    virtual Wires_t doExtractWires(Path_t& path) override;
+
+
+      private:
+
+    /// Layouts of the created planes, by volume name.
+    std::map<std::string, PlaneLayout_t> fLayouts;
+
+    /// Name of the volume containing all the wire nodes.
+    static constexpr char const* ContainerName = "volSyntheticWires";
+
+    /// Container of the created wire volumes (created on first use).
+    TGeoVolumeAssembly* fContainer = nullptr;
+
+    /// Wire volumes, by plane layout and length.
+    std::map<std::pair<std::string, long long>, TGeoVolume*> fWireVolumes;
+
+    /// Number of nodes of the container used by this builder.
+    int fUsedNodes = 0;
+
+    /// Creates the wires of the plane at `path` according to `layout`.
+    Wires_t makeWires(Path_t const& path, PlaneLayout_t const& layout);
+
+    /// Returns the wire container of the current ROOT geometry (may create).
+    static TGeoVolumeAssembly* findOrCreateContainer();
+
+    /// Returns the volume for `wire` in the current ROOT geometry (may create).
+    static TGeoVolume* findOrCreateWireVolume(
+      PlaneLayout_t const& layout, WireLayout_t const& wire,
+      TGeoVolume const& planeVolume
+      );
+
+    /// Returns the next node of a wire with `volume` (reused or added).
+    TGeoNode const& nextWireNode(TGeoVolume& volume);
+
+  }; // class GeometryBuilderSyntheticWires
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYBUILDERSYNTHETICWIRES_H
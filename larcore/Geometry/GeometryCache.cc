@@ -0,0 +1,147 @@
+/**
+ * @file   larcore/Geometry/GeometryCache.cc
+ * @brief  Persistent binary snapshots of the ROOT geometry description.
+ * @see    larcore/Geometry/GeometryCache.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometryCache.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "cetlib_except/exception.h"
+#include "cetlib/MD5Digest.h"
+
+// ROOT libraries
+#include "TGeoManager.h"
+
+// C/C++ standard libraries
+#include <fstream>
+#include <utility> // std::move()
+#include <cstdio> // std::rename(), std::remove()
+#include <unistd.h> // getpid()
+
+
+namespace {
+
+  /// Splits `path` into directory (with trailing `/`) and file name.
+  std::pair<std::string, std::string> splitPath(std::string const& path) {
+    auto const iSep = path.rfind('/');
+    if (iSep == std::string::npos) return { "", path };
+    return { path.substr(0, iSep + 1), path.substr(iSep + 1) };
+  } // splitPath()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+geo::GeometryCache::GeometryCache(std::string directory, bool writeMissing)
+  : fDirectory(std::move(directory))
+  , fWriteMissing(writeMissing)
+{
+  // add a final directory separator ("/") if not already there
+  if (!fDirectory.empty() && (fDirectory.back() != '/')) fDirectory += '/';
+} // geo::GeometryCache::GeometryCache()
+
+
+//------------------------------------------------------------------------------
+std::string geo::GeometryCache::CacheKey(
+  std::string const& geometryFile,
+  std::vector<fhicl::ParameterSet> const& config
+) {
+
+  std::ifstream file(geometryFile, std::ios::binary);
+  if (!file) {
+    throw cet::exception("GeometryCache")
+      << "cannot read the geometry file '" << geometryFile << "'\n";
+  }
+
+  cet::MD5Digest digest;
+  std::string buffer(1 << 20, '\0');
+  while (file) {
+    file.read(buffer.data(), buffer.size());
+    auto const nRead = file.gcount();
+    if (nRead > 0) digest.append(buffer.substr(0, nRead));
+  } // while
+
+  for (fhicl::ParameterSet const& pset: config)
+    digest.append(pset.id().to_string());
+
+  return digest.digest().toString();
+
+} // geo::GeometryCache::CacheKey()
+
+
+//------------------------------------------------------------------------------
+std::string geo::GeometryCache::ExtendKey
+  (std::string const& key, std::vector<fhicl::ParameterSet> const& config)
+{
+  cet::MD5Digest digest;
+  digest.append(key);
+  for (fhicl::ParameterSet const& pset: config)
+    digest.append(pset.id().to_string());
+  return digest.digest().toString();
+} // geo::GeometryCache::ExtendKey()
+
+
+//------------------------------------------------------------------------------
+std::string geo::GeometryCache::SnapshotPath
+  (std::string const& geometryFile, std::string const& key) const
+{
+  auto const [ sourceDir, fileName ] = splitPath(geometryFile);
+  return (fDirectory.empty()? sourceDir: fDirectory)
+    + fileName + '.' + key + ".root";
+} // geo::GeometryCache::SnapshotPath()
+
+
+//------------------------------------------------------------------------------
+std::string geo::GeometryCache::FindSnapshot
+  (std::string const& geometryFile, std::string const& key) const
+{
+  std::string const path = SnapshotPath(geometryFile, key);
+  return std::ifstream(path).good()? path: std::string{};
+} // geo::GeometryCache::FindSnapshot()
+
+
+//------------------------------------------------------------------------------
+bool geo::GeometryCache::StoreSnapshot
+  (std::string const& geometryFile, std::string const& key) const
+{
+  if (!fWriteMissing) return false;
+
+  if (!gGeoManager) {
+    mf::LogWarning("GeometryCache")
+      << "No ROOT geometry loaded: snapshot of '" << geometryFile
+      << "' not written.";
+    return false;
+  }
+
+  std::string const path = SnapshotPath(geometryFile, key);
+
+  // TGeoManager::Export() decides the format from the file name suffix
+  std::string const tempPath
+    = path + ".tmp" + std::to_string(::getpid()) + ".root";
+
+  if (gGeoManager->Export(tempPath.c_str()) == 0) {
+    std::remove(tempPath.c_str());
+    mf::LogWarning("GeometryCache")
+      << "Failed to write geometry snapshot '" << path << "'.";
+    return false;
+  }
+
+  if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+    std::remove(tempPath.c_str());
+    mf::LogWarning("GeometryCache")
+      << "Failed to move geometry snapshot into '" << path << "'.";
+    return false;
+  }
+
+  mf::LogInfo("GeometryCache")
+    << "Geometry snapshot of '" << geometryFile << "' written into '"
+    << path << "'";
+  return true;
+
+} // geo::GeometryCache::StoreSnapshot()
+
+
+//------------------------------------------------------------------------------
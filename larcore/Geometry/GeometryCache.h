@@ -0,0 +1,128 @@
+/**
+ * @file   larcore/Geometry/GeometryCache.h
+ * @brief  Persistent binary snapshots of the ROOT geometry description.
+ * @see    larcore/Geometry/GeometryCache.cc
+ *
+ * This library depends on ROOT geometry library and on cetlib.
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYCACHE_H
+#define LARCORE_GEOMETRY_GEOMETRYCACHE_H
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard libraries
+#include <string>
+#include <vector>
+
+
+namespace geo {
+
+  /**
+   * @brief Manages binary snapshots of a geometry description.
+   *
+   * Parsing a large GDML file into `TGeoManager` takes a long time, and the
+   * result is always the same for the same file.
+   * This object keeps a cache of ROOT files, each with a `TGeoManager` exported
+   * right after the GDML file was parsed, so that following jobs can load that
+   * binary file instead of parsing the GDML description again.
+   *
+   * Each snapshot is identified by a key which is derived from the content of
+   * the geometry description file and from the configuration of the geometry
+   * (see `CacheKey()`). The snapshot file is named after the original file:
+   * `<directory>/<basename>.<key>.root`.
+   *
+   * The cache directory is by default the one of the geometry description file
+   * itself. If a directory is explicitly specified, it is used instead.
+   *
+   * Snapshot files are written atomically: a temporary file is written and
+   * then renamed into its final name, so that concurrent jobs never load a
+   * partially written snapshot.
+   *
+   * @note Only the ROOT geometry (`TGeoManager`) is cached. The LArSoft
+   *       geometry objects (`geo::CryostatGeo` etc.) refer to ROOT geometry
+   *       nodes and still need to be built by the geometry builder, which is
+   *       a fast operation compared to the GDML parsing.
+   */
+  class GeometryCache {
+
+      public:
+
+    /**
+     * @brief Constructor: sets the cache parameters.
+     * @param directory where to find and write the snapshots
+     *                  (empty: same directory as the geometry description)
+     * @param writeMissing whether to create a snapshot when not available
+     */
+    GeometryCache(std::string directory, bool writeMissing);
+
+
+    /**
+     * @brief Returns the key for the specified geometry file and configuration.
+     * @param geometryFile path of the geometry description file
+     * @param config configuration parameter sets affecting the geometry
+     * @return a string identifying the specified geometry
+     * @throw cet::exception (category: `"GeometryCache"`) if file is unreadable
+     *
+     * The key is a digest of the content of the geometry file and of the
+     * identifiers of all the specified parameter sets.
+     */
+    static std::string CacheKey(
+      std::string const& geometryFile,
+      std::vector<fhicl::ParameterSet> const& config
+      );
+
+    /**
+     * @brief Returns a key extending `key` with more configuration.
+     * @param key a key, as returned by `CacheKey()`
+     * @param config additional configuration parameter sets
+     * @return a string identifying the key and the additional configuration
+     *
+     * This allows keys for the information derived from a geometry with
+     * different configurations, without reading the geometry file again.
+     */
+    static std::string ExtendKey
+      (std::string const& key, std::vector<fhicl::ParameterSet> const& config);
+
+    /// Returns the path of the snapshot for the specified file and key.
+    std::string SnapshotPath
+      (std::string const& geometryFile, std::string const& key) const;
+
+    /**
+     * @brief Returns the path of an existing snapshot.
+     * @param geometryFile path of the geometry description file
+     * @param key geometry key, as returned by `CacheKey()`
+     * @return the path of the snapshot, or an empty string if not available
+     */
+    std::string FindSnapshot
+      (std::string const& geometryFile, std::string const& key) const;
+
+    /**
+     * @brief Writes the current ROOT geometry as a snapshot.
+     * @param geometryFile path of the geometry description file
+     * @param key geometry key, as returned by `CacheKey()`
+     * @return whether the snapshot was successfully written
+     *
+     * The geometry in `gGeoManager` is exported.
+     * If writing of snapshots is disabled, nothing is done and `false` is
+     * returned. Failures are not fatal: the cache is just not updated.
+     */
+    bool StoreSnapshot
+      (std::string const& geometryFile, std::string const& key) const;
+
+    /// Returns whether missing snapshots are written.
+    bool writesMissing() const { return fWriteMissing; }
+
+
+      private:
+
+    std::string fDirectory; ///< Cache directory (empty: next to the source).
+    bool fWriteMissing; ///< Whether to write snapshots when missing.
+
+  }; // class GeometryCache
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYCACHE_H
@@ -0,0 +1,195 @@
+/**
+ * @file   larcore/Geometry/GeometryFileLocator.cc
+ * @brief  Process-wide cache of the geometry files found in the search path.
+ * @see    larcore/Geometry/GeometryFileLocator.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometryFileLocator.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "cetlib/search_path.h"
+
+// C/C++ standard libraries
+#include <exception> // std::current_exception()
+#include <fstream>
+#include <utility> // std::move()
+#include <cstdlib> // std::getenv()
+
+// POSIX
+#include <sys/stat.h> // ::stat()
+
+
+namespace {
+
+  /// Returns whether `path` names an existing regular file.
+  bool isRegularFile(std::string const& path) {
+    struct ::stat info;
+    return (::stat(path.c_str(), &info) == 0) && S_ISREG(info.st_mode);
+  } // isRegularFile()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+geo::GeometryFileLocator& geo::GeometryFileLocator::Instance() {
+  static GeometryFileLocator locator;
+  return locator;
+} // geo::GeometryFileLocator::Instance()
+
+
+//------------------------------------------------------------------------------
+bool geo::GeometryFileLocator::FindFile
+  (std::string const& fileName, std::string& fullPath)
+{
+  Key_t const key { searchPathValue(), fileName };
+
+  // the first request of a file performs the search, the others wait for it
+  std::promise<std::string> promise;
+  std::shared_future<std::string> result;
+  bool owner = false;
+  {
+    std::lock_guard<std::mutex> const lock { fMutex };
+    auto const iResult = fResolved.find(key);
+    if (iResult == fResolved.end()) {
+      result = promise.get_future().share();
+      fResolved.emplace(key, result);
+      owner = true;
+    }
+    else result = iResult->second;
+  }
+
+  if (owner) {
+    try {
+      std::string found = resolve(key);
+      if (found.empty()) { // failures are not remembered
+        std::lock_guard<std::mutex> const lock { fMutex };
+        fResolved.erase(key);
+      }
+      promise.set_value(std::move(found));
+    }
+    catch (...) {
+      {
+        std::lock_guard<std::mutex> const lock { fMutex };
+        fResolved.erase(key);
+      }
+      promise.set_exception(std::current_exception());
+    }
+  } // if owner
+
+  std::string const& found = result.get();
+  if (found.empty()) return false;
+  fullPath = found;
+  return true;
+} // geo::GeometryFileLocator::FindFile()
+
+
+//------------------------------------------------------------------------------
+void geo::GeometryFileLocator::UseManifest(std::string const& manifestPath) {
+
+  std::lock_guard<std::mutex> const lock { fMutex };
+
+  if (!fManifestPath.empty()) {
+    if (manifestPath != fManifestPath) {
+      mf::LogWarning("GeometryFileLocator")
+        << "Ignoring request of manifest '" << manifestPath
+        << "': already using '" << fManifestPath << "'.";
+    }
+    return;
+  }
+  fManifestPath = manifestPath;
+
+  std::ifstream manifest(fManifestPath);
+  if (!manifest) return; // not created yet
+
+  std::string line;
+  std::size_t nEntries = 0U;
+  while (std::getline(manifest, line)) {
+    auto const firstTab = line.find('\t');
+    if (firstTab == std::string::npos) continue;
+    auto const secondTab = line.find('\t', firstTab + 1);
+    if (secondTab == std::string::npos) continue;
+    // later entries supersede earlier ones
+    fManifest[{ line.substr(0, firstTab),
+                line.substr(firstTab + 1, secondTab - firstTab - 1) }]
+      = line.substr(secondTab + 1);
+    ++nEntries;
+  } // while
+  mf::LogInfo("GeometryFileLocator") << "Read " << nEntries
+    << " resolved paths from manifest '" << fManifestPath << "'";
+
+} // geo::GeometryFileLocator::UseManifest()
+
+
+//------------------------------------------------------------------------------
+std::size_t geo::GeometryFileLocator::NSearches() const {
+  std::lock_guard<std::mutex> const lock { fMutex };
+  return fNSearches;
+} // geo::GeometryFileLocator::NSearches()
+
+
+//------------------------------------------------------------------------------
+std::string geo::GeometryFileLocator::resolve(Key_t const& key) {
+
+  // a path from the manifest costs a single check
+  std::string fromManifest;
+  {
+    std::lock_guard<std::mutex> const lock { fMutex };
+    auto const iEntry = fManifest.find(key);
+    if (iEntry != fManifest.end()) fromManifest = iEntry->second;
+  }
+  if (!fromManifest.empty()) {
+    if (isRegularFile(fromManifest)) return fromManifest;
+    mf::LogWarning("GeometryFileLocator") << "Path '" << fromManifest
+      << "' from manifest for '" << key.second
+      << "' does not exist any more: searching again.";
+  }
+
+  // cet::search_path constructor decides if initialized value is a path
+  // or an environment variable
+  cet::search_path const sp { "FW_SEARCH_PATH" };
+  std::string fullPath;
+  bool const found = sp.find_file(key.second, fullPath);
+  {
+    std::lock_guard<std::mutex> const lock { fMutex };
+    ++fNSearches;
+  }
+  if (!found) return {};
+
+  appendToManifest(key, fullPath);
+  return fullPath;
+} // geo::GeometryFileLocator::resolve()
+
+
+//------------------------------------------------------------------------------
+void geo::GeometryFileLocator::appendToManifest
+  (Key_t const& key, std::string const& fullPath)
+{
+  std::lock_guard<std::mutex> const lock { fMutex };
+  if (fManifestPath.empty()) return;
+
+  // each entry is written at once, so that concurrent jobs do not mix lines
+  std::string const line
+    = key.first + '\t' + key.second + '\t' + fullPath + '\n';
+  std::ofstream manifest(fManifestPath, std::ios::app);
+  manifest.write(line.data(), line.size());
+  manifest.flush();
+  if (!manifest) {
+    mf::LogWarning("GeometryFileLocator")
+      << "Failed to record '" << fullPath << "' into manifest '"
+      << fManifestPath << "'.";
+  }
+  else fManifest[key] = fullPath;
+
+} // geo::GeometryFileLocator::appendToManifest()
+
+
+//------------------------------------------------------------------------------
+std::string geo::GeometryFileLocator::searchPathValue() {
+  char const* value = std::getenv("FW_SEARCH_PATH");
+  return value? value: "";
+} // geo::GeometryFileLocator::searchPathValue()
+
+
+//------------------------------------------------------------------------------
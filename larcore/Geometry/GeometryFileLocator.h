@@ -0,0 +1,108 @@
+/**
+ * @file   larcore/Geometry/GeometryFileLocator.h
+ * @brief  Process-wide cache of the geometry files found in the search path.
+ * @see    larcore/Geometry/GeometryFileLocator.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYFILELOCATOR_H
+#define LARCORE_GEOMETRY_GEOMETRYFILELOCATOR_H
+
+// C/C++ standard libraries
+#include <future> // std::shared_future<>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility> // std::pair<>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  /**
+   * @brief Finds geometry files in `FW_SEARCH_PATH`, remembering the results.
+   *
+   * Looking for a file in a long search path requires probing each of its
+   * directories, which can be slow on network file systems. The geometry
+   * services (`geo::Geometry` and `geo::AuxDetGeometry`) look for the same
+   * files (and the GDML and ROOT files are usually the same file): this
+   * process-wide locator performs each search only once, and serves the
+   * following requests of the same file from memory. Concurrent requests for
+   * the same file wait for a single search.
+   *
+   * Results are identified by the file name and by the value of the search
+   * path at the time of the request, so that a change of `FW_SEARCH_PATH`
+   * triggers new searches. Files that are not found are not remembered.
+   *
+   * Resolved paths can also be kept in a _manifest_ file (`UseManifest()`),
+   * which is read at start and extended with each new search result: a
+   * following job with the same search path finds the files there, and
+   * checks only that they still exist instead of probing the search path.
+   * Each line of the manifest holds the search path, the requested file name
+   * and the resolved path, separated by tabulation characters.
+   */
+  class GeometryFileLocator {
+
+      public:
+
+    /// Returns the locator of this process.
+    static GeometryFileLocator& Instance();
+
+    /**
+     * @brief Looks for a file in `FW_SEARCH_PATH`.
+     * @param fileName name of the file, relative to the search path
+     * @param[out] fullPath full path of the file found
+     * @return whether the file was found
+     *
+     * The interface is the same as `cet::search_path::find_file()`;
+     * `fullPath` is left unchanged if the file is not found.
+     */
+    bool FindFile(std::string const& fileName, std::string& fullPath);
+
+    /**
+     * @brief Uses the specified file as manifest of resolved paths.
+     * @param manifestPath path of the manifest file
+     *
+     * The content of the manifest, if the file exists, is read immediately.
+     * Only one manifest per process is supported: requests for a different
+     * manifest are ignored with a warning.
+     */
+    void UseManifest(std::string const& manifestPath);
+
+    /// Returns the number of searches performed in the search path.
+    std::size_t NSearches() const;
+
+
+      private:
+
+    /// Key identifying a search: search path and file name.
+    using Key_t = std::pair<std::string, std::string>;
+
+    mutable std::mutex fMutex; ///< Serializes all the bookkeeping.
+
+    /// Results of the searches (empty if not found).
+    std::map<Key_t, std::shared_future<std::string>> fResolved;
+
+    /// Paths read from the manifest, not verified yet.
+    std::map<Key_t, std::string> fManifest;
+
+    std::string fManifestPath; ///< Manifest file (empty if none).
+
+    std::size_t fNSearches = 0U; ///< Number of searches performed.
+
+    GeometryFileLocator() = default;
+
+    /// Returns the resolved path of `key`, searching if needed.
+    std::string resolve(Key_t const& key);
+
+    /// Appends a newly resolved path to the manifest.
+    void appendToManifest(Key_t const& key, std::string const& fullPath);
+
+    /// Returns the current value of `FW_SEARCH_PATH`.
+    static std::string searchPathValue();
+
+  }; // class GeometryFileLocator
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYFILELOCATOR_H
@@ -0,0 +1,41 @@
+/**
+ * @file   larcore/Geometry/GeometryIDIndexer.cc
+ * @brief  Dense, contiguous indexing of TPC, plane and wire IDs.
+ * @see    larcore/Geometry/GeometryIDIndexer.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometryIDIndexer.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+
+
+//------------------------------------------------------------------------------
+geo::GeometryIDIndexer::GeometryIDIndexer(geo::GeometryCore const& geom) {
+
+  fCryoTPCOffsets.push_back(0);
+  fTPCPlaneOffsets.push_back(0);
+  fPlaneWireOffsets.push_back(0);
+
+  for (geo::CryostatID const& cid: geom.IterateCryostatIDs()) {
+    unsigned int const nTPCs = geom.NTPC(cid);
+    fCryoTPCOffsets.push_back(fCryoTPCOffsets.back() + nTPCs);
+
+    for (unsigned int t = 0; t < nTPCs; ++t) {
+      geo::TPCID const tpcid { cid, t };
+      unsigned int const nPlanes = geom.Nplanes(tpcid);
+      fTPCPlaneOffsets.push_back(fTPCPlaneOffsets.back() + nPlanes);
+
+      for (unsigned int p = 0; p < nPlanes; ++p) {
+        geo::PlaneID const planeid { tpcid, p };
+        fPlaneWireOffsets.push_back
+          (fPlaneWireOffsets.back() + geom.Nwires(planeid));
+      } // for planes
+    } // for TPCs
+  } // for cryostats
+
+} // geo::GeometryIDIndexer::GeometryIDIndexer()
+
+
+//------------------------------------------------------------------------------
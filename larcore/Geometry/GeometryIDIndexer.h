@@ -0,0 +1,139 @@
+/**
+ * @file   larcore/Geometry/GeometryIDIndexer.h
+ * @brief  Dense, contiguous indexing of TPC, plane and wire IDs.
+ * @see    larcore/Geometry/GeometryIDIndexer.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYIDINDEXER_H
+#define LARCORE_GEOMETRY_GEOMETRYIDINDEXER_H
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <limits>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  class GeometryCore;
+
+  /**
+   * @brief Maps geometry IDs into a dense index.
+   *
+   * All the TPCs of the detector are assigned a index starting from `0`,
+   * in the order of their ID (cryostat first, then TPC).
+   * The same happens for all planes and all wires in the detector.
+   * This allows to store information about all elements of a given type in a
+   * single contiguous array.
+   *
+   * The indices of invalid or out-of-range IDs are `InvalidIndex`.
+   * The validity flag of the IDs is not checked.
+   */
+  class GeometryIDIndexer {
+
+      public:
+
+    /// Value of index used for elements not in the geometry.
+    static constexpr std::size_t InvalidIndex
+      = std::numeric_limits<std::size_t>::max();
+
+    /// Constructor: an empty index.
+    GeometryIDIndexer() = default;
+
+    /// Constructor: indexes all elements in the specified geometry.
+    explicit GeometryIDIndexer(geo::GeometryCore const& geom);
+
+    /// Returns the total number of TPCs in the detector.
+    std::size_t NTPCs() const { return count(fTPCPlaneOffsets); }
+
+    /// Returns the total number of wire planes in the detector.
+    std::size_t NPlanes() const { return count(fPlaneWireOffsets); }
+
+    /// Returns the total number of wires in the detector.
+    std::size_t NWires() const
+      { return fPlaneWireOffsets.empty()? 0: fPlaneWireOffsets.back(); }
+
+    /// Returns the dense index of the specified TPC.
+    std::size_t TPCIndex(geo::TPCID const& tpcid) const;
+
+    /// Returns the dense index of the specified plane.
+    std::size_t PlaneIndex(geo::PlaneID const& planeid) const;
+
+    /// Returns the dense index of the specified wire.
+    std::size_t WireIndex(geo::WireID const& wireid) const;
+
+    /// Returns the dense index of the first wire of the plane with `planeIndex`.
+    std::size_t FirstWireIndex(std::size_t planeIndex) const
+      { return fPlaneWireOffsets[planeIndex]; }
+
+
+      private:
+
+    /// Offset of first TPC of each cryostat, plus the total TPC count.
+    std::vector<std::size_t> fCryoTPCOffsets;
+
+    /// Offset of first plane of each TPC, plus the total plane count.
+    std::vector<std::size_t> fTPCPlaneOffsets;
+
+    /// Offset of first wire of each plane, plus the total wire count.
+    std::vector<std::size_t> fPlaneWireOffsets;
+
+    /// Returns `index` if in `[ offsets[i], offsets[i+1] [`, else invalid.
+    static std::size_t offsetIndex(
+      std::vector<std::size_t> const& offsets, std::size_t i, std::size_t index
+      );
+
+    /// Number of elements covered by an offset list.
+    static std::size_t count(std::vector<std::size_t> const& offsets)
+      { return offsets.empty()? 0: offsets.size() - 1; }
+
+  }; // class GeometryIDIndexer
+
+} // namespace geo
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//------------------------------------------------------------------------------
+inline std::size_t geo::GeometryIDIndexer::offsetIndex(
+  std::vector<std::size_t> const& offsets, std::size_t i, std::size_t index
+) {
+  if (i >= count(offsets)) return InvalidIndex;
+  std::size_t const flatIndex = offsets[i] + index;
+  return (flatIndex < offsets[i + 1])? flatIndex: InvalidIndex;
+} // geo::GeometryIDIndexer::offsetIndex()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t geo::GeometryIDIndexer::TPCIndex
+  (geo::TPCID const& tpcid) const
+  { return offsetIndex(fCryoTPCOffsets, tpcid.Cryostat, tpcid.TPC); }
+
+
+//------------------------------------------------------------------------------
+inline std::size_t geo::GeometryIDIndexer::PlaneIndex
+  (geo::PlaneID const& planeid) const
+{
+  std::size_t const tpcIndex = TPCIndex(planeid);
+  return (tpcIndex == InvalidIndex)
+    ? InvalidIndex: offsetIndex(fTPCPlaneOffsets, tpcIndex, planeid.Plane);
+} // geo::GeometryIDIndexer::PlaneIndex()
+
+
+//------------------------------------------------------------------------------
+inline std::size_t geo::GeometryIDIndexer::WireIndex
+  (geo::WireID const& wireid) const
+{
+  std::size_t const planeIndex = PlaneIndex(wireid);
+  return (planeIndex == InvalidIndex)
+    ? InvalidIndex: offsetIndex(fPlaneWireOffsets, planeIndex, wireid.Wire);
+} // geo::GeometryIDIndexer::WireIndex()
+
+
+//------------------------------------------------------------------------------
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYIDINDEXER_H
@@ -0,0 +1,41 @@
+/**
+ * @file   larcore/Geometry/GeometryIDTable.cc
+ * @brief  Flat arrays of all the geometry IDs and channels, for fast loops.
+ * @see    larcore/Geometry/GeometryIDTable.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometryIDTable.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+
+
+//------------------------------------------------------------------------------
+geo::GeometryIDTable::GeometryIDTable(geo::GeometryCore const& geom) {
+
+  for (geo::CryostatID const& cryoid: geom.IterateCryostatIDs())
+    fCryostats.push_back(cryoid);
+  for (geo::TPCID const& tpcid: geom.IterateTPCIDs())
+    fTPCs.push_back(tpcid);
+  for (geo::PlaneID const& planeid: geom.IteratePlaneIDs())
+    fPlanes.push_back(planeid);
+
+  std::size_t nWires = 0U;
+  for (geo::PlaneID const& planeid: fPlanes) nWires += geom.Nwires(planeid);
+  fWires.reserve(nWires);
+  fWireChannels.reserve(nWires);
+  for (geo::WireID const& wireid: geom.IterateWireIDs()) {
+    fWires.push_back(wireid);
+    fWireChannels.push_back(geom.PlaneWireToChannel(wireid));
+  }
+
+  unsigned int const nChannels = geom.Nchannels();
+  fChannels.reserve(nChannels);
+  for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel)
+    fChannels.push_back(channel);
+
+} // geo::GeometryIDTable::GeometryIDTable()
+
+
+//------------------------------------------------------------------------------
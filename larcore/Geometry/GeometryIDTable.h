@@ -0,0 +1,113 @@
+/**
+ * @file   larcore/Geometry/GeometryIDTable.h
+ * @brief  Flat arrays of all the geometry IDs and channels, for fast loops.
+ * @see    larcore/Geometry/GeometryIDTable.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYIDTABLE_H
+#define LARCORE_GEOMETRY_GEOMETRYIDTABLE_H
+
+// LArSoft libraries
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  class GeometryCore;
+
+  /**
+   * @brief All the geometry IDs and channels, in contiguous arrays.
+   *
+   * The IDs of all the cryostats, TPCs, planes and wires are stored at
+   * construction in contiguous arrays, in the same order as the geometry
+   * iterators (e.g. `geo::GeometryCore::IterateWireIDs()`) and of
+   * `geo::GeometryIDIndexer`. The channel of each wire is also stored,
+   * in an array parallel to the one of the wire IDs, together with the list
+   * of all the channels.
+   *
+   * Each array is returned as a `Span_t`, a range of contiguous elements whose
+   * iterators are plain pointers. Compared to the geometry iterators, there
+   * is no validity check nor ID arithmetic at each step, and the ranges can
+   * also be processed with random access, for example by parallel algorithms:
+   *
+   *     auto const& wires = geom.IDTable()->Wires();
+   *     auto const& channels = geom.IDTable()->WireChannels();
+   *     for (std::size_t i = 0; i < wires.size(); ++i)
+   *       calibrate(wires[i], channels[i]);
+   *
+   * The table is immutable, and it must be built again for each new geometry
+   * and channel mapping.
+   */
+  class GeometryIDTable {
+
+      public:
+
+    /// Range of contiguous elements of type `T`.
+    template <typename T>
+    class Span_t {
+      T const* fBegin = nullptr;
+      T const* fEnd = nullptr;
+        public:
+      using value_type = T;
+      using const_iterator = T const*;
+      Span_t() = default;
+      explicit Span_t(std::vector<T> const& v)
+        : fBegin(v.data()), fEnd(v.data() + v.size()) {}
+      T const* begin() const { return fBegin; }
+      T const* end() const { return fEnd; }
+      T const* data() const { return fBegin; }
+      std::size_t size() const { return fEnd - fBegin; }
+      bool empty() const { return fBegin == fEnd; }
+      T const& operator[] (std::size_t i) const { return fBegin[i]; }
+    }; // Span_t
+
+
+    /// Constructor: an empty table.
+    GeometryIDTable() = default;
+
+    /// Constructor: collects all the IDs and channels of `geom`.
+    explicit GeometryIDTable(geo::GeometryCore const& geom);
+
+    /// Returns the IDs of all the cryostats.
+    Span_t<geo::CryostatID> Cryostats() const
+      { return Span_t<geo::CryostatID>{ fCryostats }; }
+
+    /// Returns the IDs of all the TPCs.
+    Span_t<geo::TPCID> TPCs() const { return Span_t<geo::TPCID>{ fTPCs }; }
+
+    /// Returns the IDs of all the planes.
+    Span_t<geo::PlaneID> Planes() const
+      { return Span_t<geo::PlaneID>{ fPlanes }; }
+
+    /// Returns the IDs of all the wires.
+    Span_t<geo::WireID> Wires() const { return Span_t<geo::WireID>{ fWires }; }
+
+    /// Returns the channel of each wire, in the same order as `Wires()`.
+    Span_t<raw::ChannelID_t> WireChannels() const
+      { return Span_t<raw::ChannelID_t>{ fWireChannels }; }
+
+    /// Returns all the channels, in increasing order.
+    Span_t<raw::ChannelID_t> Channels() const
+      { return Span_t<raw::ChannelID_t>{ fChannels }; }
+
+
+      private:
+
+    std::vector<geo::CryostatID> fCryostats; ///< All cryostat IDs.
+    std::vector<geo::TPCID> fTPCs; ///< All TPC IDs.
+    std::vector<geo::PlaneID> fPlanes; ///< All plane IDs.
+    std::vector<geo::WireID> fWires; ///< All wire IDs.
+    std::vector<raw::ChannelID_t> fWireChannels; ///< Channel of each wire.
+    std::vector<raw::ChannelID_t> fChannels; ///< All channels.
+
+  }; // class GeometryIDTable
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYIDTABLE_H
@@ -0,0 +1,101 @@
+/**
+ * @file   larcore/Geometry/GeometryLoadProfiler.cc
+ * @brief  Collection of time and memory statistics of the geometry loading.
+ * @see    larcore/Geometry/GeometryLoadProfiler.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometryLoadProfiler.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::find_if(), std::max()
+#include <iterator> // std::prev()
+#include <utility> // std::move()
+#include <sys/resource.h> // getrusage()
+
+
+//------------------------------------------------------------------------------
+geo::GeometryLoadProfiler::Timer::Timer
+  (GeometryLoadProfiler const* profiler, std::string name)
+  : fProfiler(profiler)
+  , fName(std::move(name))
+  , fStart(fProfiler? Clock_t::now(): Clock_t::time_point{})
+  {}
+
+
+//------------------------------------------------------------------------------
+void geo::GeometryLoadProfiler::Timer::stop() {
+  if (!fProfiler) return;
+  std::chrono::duration<double> const elapsed = Clock_t::now() - fStart;
+  fProfiler->Record(fName, elapsed.count());
+  fProfiler = nullptr;
+} // geo::GeometryLoadProfiler::Timer::stop()
+
+
+//------------------------------------------------------------------------------
+geo::GeometryLoadProfiler::GeometryLoadProfiler
+  (std::string category, bool enabled)
+  : fCategory(std::move(category))
+  , fEnabled(enabled)
+  {}
+
+
+//------------------------------------------------------------------------------
+void geo::GeometryLoadProfiler::Record
+  (std::string const& name, double seconds) const
+{
+  long const peakRSS = PeakRSS();
+
+  {
+    std::lock_guard<std::mutex> const lock { fStatsMutex };
+    auto iStats = std::find_if(fStats.begin(), fStats.end(),
+      [&name](StepStats_t const& stats){ return stats.name == name; });
+    if (iStats == fStats.end()) {
+      fStats.emplace_back();
+      iStats = std::prev(fStats.end());
+      iStats->name = name;
+    }
+    ++(iStats->calls);
+    iStats->totalTime += seconds;
+    iStats->maxTime = std::max(iStats->maxTime, seconds);
+    iStats->peakRSS = std::max(iStats->peakRSS, peakRSS);
+  }
+
+  mf::LogInfo(fCategory) << "Geometry loading step '" << name << "' took "
+    << seconds << " s (peak RSS: " << (peakRSS / 1024) << " MiB)";
+
+} // geo::GeometryLoadProfiler::Record()
+
+
+//------------------------------------------------------------------------------
+auto geo::GeometryLoadProfiler::Stats() const -> std::vector<StepStats_t> {
+  std::lock_guard<std::mutex> const lock { fStatsMutex };
+  return fStats;
+} // geo::GeometryLoadProfiler::Stats()
+
+
+//------------------------------------------------------------------------------
+void geo::GeometryLoadProfiler::PrintSummary
+  (std::ostream& out, std::string const& indent /* = "" */) const
+{
+  out << indent << "step;calls;total time [s];longest time [s];peak RSS [kiB]";
+  for (StepStats_t const& stats: Stats()) {
+    out << "\n" << indent << stats.name << ';' << stats.calls
+      << ';' << stats.totalTime << ';' << stats.maxTime
+      << ';' << stats.peakRSS;
+  } // for
+} // geo::GeometryLoadProfiler::PrintSummary()
+
+
+//------------------------------------------------------------------------------
+long geo::GeometryLoadProfiler::PeakRSS() {
+  struct rusage usage;
+  if (::getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+  return usage.ru_maxrss; // on Linux, in kiB
+} // geo::GeometryLoadProfiler::PeakRSS()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,112 @@
+/**
+ * @file   larcore/Geometry/GeometryLoadProfiler.h
+ * @brief  Collection of time and memory statistics of the geometry loading.
+ * @see    larcore/Geometry/GeometryLoadProfiler.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYLOADPROFILER_H
+#define LARCORE_GEOMETRY_GEOMETRYLOADPROFILER_H
+
+// C/C++ standard libraries
+#include <chrono>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility> // std::move()
+#include <vector>
+
+
+namespace geo {
+
+  /**
+   * @brief Measures the cost of the steps of the geometry loading.
+   *
+   * Each step is measured by a timer object, created by `Step()`, which
+   * records the elapsed (wall clock) time from its creation to its
+   * destruction (or to an explicit `Timer::stop()`), and the peak resident
+   * memory of the process at that moment.
+   * The statistics of all the steps with the same name are accumulated.
+   *
+   * If enabled, each measurement is also reported via message facility at
+   * the end of each step (`INFO` level), and a summary of all the steps can
+   * be printed as a table (`PrintSummary()`) whose lines have the format:
+   *
+   *     <step name>;<calls>;<total time [s]>;<longest time [s]>;<peak RSS [kiB]>
+   *
+   * When disabled, no measurement is performed.
+   * Steps can be recorded concurrently, and also from `const` code, since the
+   * collected statistics are not considered part of the state of the object.
+   */
+  class GeometryLoadProfiler {
+
+    using Clock_t = std::chrono::steady_clock;
+
+      public:
+
+    /// Statistics of a single step.
+    struct StepStats_t {
+      std::string name;       ///< Name of the step.
+      unsigned int calls = 0; ///< Number of times the step was measured.
+      double totalTime = 0.0; ///< Total elapsed time [s].
+      double maxTime = 0.0;   ///< Longest single elapsed time [s].
+      long peakRSS = 0;       ///< Peak resident memory after the step [kiB].
+    }; // StepStats_t
+
+
+    /// Measures the time until its destruction.
+    class Timer {
+      GeometryLoadProfiler const* fProfiler; ///< Target (none if null).
+      std::string fName; ///< Name of the measured step.
+      Clock_t::time_point fStart; ///< Start time.
+        public:
+      Timer(GeometryLoadProfiler const* profiler, std::string name);
+      Timer(Timer const&) = delete;
+      Timer& operator= (Timer const&) = delete;
+      ~Timer() { stop(); }
+
+      /// Stops the measurement and records it (only the first time).
+      void stop();
+    }; // Timer
+
+
+    /**
+     * @brief Constructor.
+     * @param category message facility category of the reports
+     * @param enabled whether to perform the measurements
+     */
+    GeometryLoadProfiler(std::string category, bool enabled);
+
+    /// Returns whether measurements are performed.
+    bool enabled() const { return fEnabled; }
+
+    /// Returns a timer measuring the step `name`.
+    Timer Step(std::string name) const
+      { return { fEnabled? this: nullptr, std::move(name) }; }
+
+    /// Records a measurement of `seconds` for the step `name`.
+    void Record(std::string const& name, double seconds) const;
+
+    /// Returns the statistics of all the steps, in order of first measurement.
+    std::vector<StepStats_t> Stats() const;
+
+    /// Prints the statistics of all steps, one per line.
+    void PrintSummary(std::ostream& out, std::string const& indent = "") const;
+
+    /// Returns the peak resident memory of the process [kiB].
+    static long PeakRSS();
+
+
+      private:
+
+    std::string fCategory; ///< Message facility category.
+    bool fEnabled; ///< Whether measurements are performed.
+
+    mutable std::vector<StepStats_t> fStats; ///< Statistics of each step.
+    mutable std::mutex fStatsMutex; ///< Protects `fStats`.
+
+  }; // class GeometryLoadProfiler
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYLOADPROFILER_H
@@ -0,0 +1,194 @@
+/**
+ * @file   larcore/Geometry/GeometryQueryCounters.cc
+ * @brief  Per-module statistics of the geometry queries.
+ * @see    larcore/Geometry/GeometryQueryCounters.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometryQueryCounters.h"
+
+// C/C++ standard libraries
+#include <utility> // std::pair<>, std::move()
+
+
+namespace {
+
+  /// Source of unique identifiers for the counter objects.
+  std::atomic<std::uint64_t> NextCountersID { 1U };
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+std::string const geo::GeometryQueryCounters::NoModule { "<none>" };
+
+
+//------------------------------------------------------------------------------
+geo::GeometryQueryCounters::Probe::Probe(Counts_t* counts, Query_t query)
+  : fCounts(counts), fQuery(query), fStart(Clock_t::now())
+  {}
+
+
+//------------------------------------------------------------------------------
+geo::GeometryQueryCounters::Probe::Probe(Probe&& from)
+  : fCounts(from.fCounts), fQuery(from.fQuery), fStart(from.fStart)
+  { from.fCounts = nullptr; }
+
+
+//------------------------------------------------------------------------------
+geo::GeometryQueryCounters::Probe::~Probe() {
+  if (!fCounts) return;
+  auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>
+    (Clock_t::now() - fStart);
+  add(fCounts->timed[fQuery], 1U);
+  add(fCounts->nanoseconds[fQuery], elapsed.count());
+} // geo::GeometryQueryCounters::Probe::~Probe()
+
+
+//------------------------------------------------------------------------------
+geo::GeometryQueryCounters::GeometryQueryCounters(unsigned int samplingPeriod)
+  : fSamplingPeriod(samplingPeriod)
+  , fID(NextCountersID.fetch_add(1U))
+  {}
+
+
+//------------------------------------------------------------------------------
+void geo::GeometryQueryCounters::EnterModule(std::string const& label) const
+{
+  ThreadData_t& data = threadData();
+  data.interrupted.push_back(data.current);
+  data.current = &moduleCounts(data, label);
+} // geo::GeometryQueryCounters::EnterModule()
+
+
+//------------------------------------------------------------------------------
+void geo::GeometryQueryCounters::LeaveModule() const {
+  ThreadData_t& data = threadData();
+  if (data.interrupted.empty()) {
+    data.current = &moduleCounts(data, NoModule);
+    return;
+  }
+  data.current = data.interrupted.back();
+  data.interrupted.pop_back();
+} // geo::GeometryQueryCounters::LeaveModule()
+
+
+//------------------------------------------------------------------------------
+auto geo::GeometryQueryCounters::Count(Query_t query) const -> Probe {
+  ThreadData_t& data = threadData();
+  add(data.current->calls[query], 1U);
+
+  if ((fSamplingPeriod == 0U) || (--data.toNextSample > 0U)) return {};
+  data.toNextSample = fSamplingPeriod;
+  return { data.current, query };
+} // geo::GeometryQueryCounters::Count()
+
+
+//------------------------------------------------------------------------------
+auto geo::GeometryQueryCounters::Stats() const -> std::vector<QueryStats_t> {
+
+  std::lock_guard<std::mutex> const lock { fMutex };
+
+  // sum the counters of all threads, by module (sorted by label)
+  std::map<std::string, std::array<QueryStats_t, NQueries>> byModule;
+  for (ThreadData_t const& data: fThreads) {
+    for (auto const& [ label, counts ]: data.counts) {
+      auto& moduleStats = byModule[label];
+      for (unsigned int q = 0; q < NQueries; ++q) {
+        QueryStats_t& stats = moduleStats[q];
+        stats.calls += counts.calls[q].load(std::memory_order_relaxed);
+        stats.timed += counts.timed[q].load(std::memory_order_relaxed);
+        stats.totalTime
+          += counts.nanoseconds[q].load(std::memory_order_relaxed) * 1e-9;
+      } // for
+    } // for modules
+  } // for threads
+
+  std::vector<QueryStats_t> allStats;
+  for (auto& [ label, moduleStats ]: byModule) {
+    for (unsigned int q = 0; q < NQueries; ++q) {
+      QueryStats_t& stats = moduleStats[q];
+      if (stats.calls == 0U) continue;
+      stats.module = label;
+      stats.query = static_cast<Query_t>(q);
+      allStats.push_back(std::move(stats));
+    } // for
+  } // for
+  return allStats;
+
+} // geo::GeometryQueryCounters::Stats()
+
+
+//------------------------------------------------------------------------------
+void geo::GeometryQueryCounters::PrintSummary
+  (std::ostream& out, std::string const& indent /* = "" */) const
+{
+  for (QueryStats_t const& stats: Stats()) {
+    out << indent << stats.module << ';' << QueryName(stats.query)
+      << ';' << stats.calls << ';' << stats.timed
+      << ';' << (stats.meanTime() * 1e9) << '\n';
+  } // for
+} // geo::GeometryQueryCounters::PrintSummary()
+
+
+//------------------------------------------------------------------------------
+char const* geo::GeometryQueryCounters::QueryName(Query_t query) {
+  switch (query) {
+    case qChannelToWire:      return "ChannelToWire";
+    case qPlaneWireToChannel: return "PlaneWireToChannel";
+    case qPositionToTPCID:    return "PositionToTPCID";
+    case qIndexedPosition:    return "IndexedPosition";
+    case qIteration:          return "Iteration";
+    case qOpChannel:          return "OpChannel";
+    case NQueries:            break;
+  } // switch
+  return "<unknown>";
+} // geo::GeometryQueryCounters::QueryName()
+
+
+//------------------------------------------------------------------------------
+auto geo::GeometryQueryCounters::threadData() const -> ThreadData_t& {
+
+  // each thread remembers its counters in each object it used,
+  // and the last ones for a quick access
+  thread_local std::uint64_t lastID = 0U;
+  thread_local ThreadData_t* lastData = nullptr;
+  thread_local std::vector<std::pair<std::uint64_t, ThreadData_t*>> known;
+  if (lastID == fID) return *lastData;
+
+  lastID = fID;
+  for (auto const& [ id, data ]: known) {
+    if (id != fID) continue;
+    lastData = data;
+    return *lastData;
+  } // for
+
+  ThreadData_t* newData = nullptr;
+  {
+    std::lock_guard<std::mutex> const lock { fMutex };
+    newData = &(fThreads.emplace_back());
+  }
+  newData->toNextSample = fSamplingPeriod;
+  newData->current = &moduleCounts(*newData, NoModule);
+  known.emplace_back(fID, newData);
+  lastData = newData;
+  return *newData;
+
+} // geo::GeometryQueryCounters::threadData()
+
+
+//------------------------------------------------------------------------------
+auto geo::GeometryQueryCounters::moduleCounts
+  (ThreadData_t& data, std::string const& label) const -> Counts_t&
+{
+  // only this thread changes `data.counts`, and `Stats()` reads it under lock:
+  // the lookup needs no lock, the addition of a new module does
+  auto const it = data.counts.find(label);
+  if (it != data.counts.end()) return it->second;
+
+  std::lock_guard<std::mutex> const lock { fMutex };
+  return data.counts[label];
+} // geo::GeometryQueryCounters::moduleCounts()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,167 @@
+/**
+ * @file   larcore/Geometry/GeometryQueryCounters.h
+ * @brief  Per-module statistics of the geometry queries.
+ * @see    larcore/Geometry/GeometryQueryCounters.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYQUERYCOUNTERS_H
+#define LARCORE_GEOMETRY_GEOMETRYQUERYCOUNTERS_H
+
+// C/C++ standard libraries
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstdint> // std::uint64_t
+
+
+namespace geo {
+
+  /**
+   * @brief Counts the geometry queries of each module.
+   *
+   * Each query is recorded by calling `Count()`, which attributes it to the
+   * module currently running on the calling thread, as set by
+   * `EnterModule()` (queries from other code, including the tasks that
+   * a module spawns on other threads, are attributed to a `<none>` module).
+   * A thread waiting within a module may run another module meanwhile:
+   * `LeaveModule()` restores the module that was current before it.
+   * Counters and module labels are kept separately for each thread, so that
+   * counting a query costs a few non-contended memory accesses, and a lock
+   * is taken only when a thread meets a module for the first time.
+   *
+   * If a sampling period is set, one query out of that many on each thread
+   * is also timed: the `Probe` object returned by `Count()` measures the time
+   * until its destruction.
+   *
+   * The statistics can be printed as a table (`PrintSummary()`) whose lines
+   * have the format:
+   *
+   *     <module>;<query>;<calls>;<timed calls>;<mean time [ns]>
+   *
+   * As for the geometry loading profiler, the collected statistics are not
+   * considered part of the state of the object.
+   */
+  class GeometryQueryCounters {
+
+    using Clock_t = std::chrono::steady_clock;
+
+      public:
+
+    /// Categories of queries.
+    enum Query_t: unsigned int {
+      qChannelToWire,      ///< `ChannelToWire()`
+      qPlaneWireToChannel, ///< `PlaneWireToChannel()`
+      qPositionToTPCID,    ///< `PositionToTPCID()`
+      qIndexedPosition,    ///< `IndexedPositionTo...()`
+      qIteration,          ///< ID iterations and `IDTable()`
+      qOpChannel,          ///< optical detector from optical channel
+      NQueries             ///< Number of query categories.
+    }; // Query_t
+
+    /// Statistics of a query category in a module.
+    struct QueryStats_t {
+      std::string module;       ///< Label of the module.
+      Query_t query;            ///< Category of the query.
+      std::uint64_t calls = 0U; ///< Number of queries.
+      std::uint64_t timed = 0U; ///< Number of timed queries.
+      double totalTime = 0.0;   ///< Total time of the timed queries [s].
+
+      /// Returns the mean time of a query [s] (`0` if none timed).
+      double meanTime() const { return timed? (totalTime / timed): 0.0; }
+    }; // QueryStats_t
+
+      private:
+
+    /// Counters of a module on a thread.
+    struct Counts_t {
+      std::array<std::atomic<std::uint64_t>, NQueries> calls {};
+      std::array<std::atomic<std::uint64_t>, NQueries> timed {};
+      std::array<std::atomic<std::uint64_t>, NQueries> nanoseconds {};
+    }; // Counts_t
+
+      public:
+
+    /// Measures the time of a sampled query until its destruction.
+    class Probe {
+      Counts_t* fCounts = nullptr; ///< Target (none if null).
+      Query_t fQuery = NQueries; ///< Category of the query.
+      Clock_t::time_point fStart; ///< Start time.
+        public:
+      Probe() = default;
+      Probe(Counts_t* counts, Query_t query);
+      Probe(Probe&& from);
+      Probe(Probe const&) = delete;
+      Probe& operator= (Probe const&) = delete;
+      Probe& operator= (Probe&&) = delete;
+      ~Probe();
+    }; // Probe
+
+
+    /// Constructor: times one query every `samplingPeriod` (`0`: none).
+    explicit GeometryQueryCounters(unsigned int samplingPeriod = 0U);
+
+    /// Attributes the following queries on this thread to module `label`.
+    void EnterModule(std::string const& label) const;
+
+    /// Attributes the following queries to the module before `EnterModule()`.
+    void LeaveModule() const;
+
+    /// Records a query of the specified category (can be timed).
+    Probe Count(Query_t query) const;
+
+    /// Returns the statistics of all modules and queries with calls.
+    std::vector<QueryStats_t> Stats() const;
+
+    /// Prints the statistics, one module and query per line.
+    void PrintSummary(std::ostream& out, std::string const& indent = "") const;
+
+    /// Returns the name of the query category.
+    static char const* QueryName(Query_t query);
+
+    /// Label of the queries not from a module.
+    static std::string const NoModule;
+
+
+      private:
+
+    /// Counters of a single thread.
+    struct ThreadData_t {
+      /// Counters by module label (only the owning thread adds to them).
+      std::map<std::string, Counts_t> counts;
+      Counts_t* current = nullptr; ///< Counters of the current module.
+      std::vector<Counts_t*> interrupted; ///< Counters of interrupted modules.
+      unsigned int toNextSample = 0U; ///< Queries until the next timing.
+    }; // ThreadData_t
+
+    unsigned int fSamplingPeriod; ///< Queries between timings (`0`: none).
+    std::uint64_t fID; ///< Unique identifier of this object.
+
+    mutable std::list<ThreadData_t> fThreads; ///< Counters of all threads.
+    mutable std::mutex fMutex; ///< Protects additions to the thread data.
+
+    /// Returns the counters of the calling thread.
+    ThreadData_t& threadData() const;
+
+    /// Returns the counters of `label` in `data` of this thread (may lock).
+    Counts_t& moduleCounts(ThreadData_t& data, std::string const& label) const;
+
+    /// Increments a counter only written by the calling thread.
+    static void add(std::atomic<std::uint64_t>& counter, std::uint64_t n)
+      {
+        counter.store
+          (counter.load(std::memory_order_relaxed) + n,
+           std::memory_order_relaxed);
+      }
+
+  }; // class GeometryQueryCounters
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYQUERYCOUNTERS_H
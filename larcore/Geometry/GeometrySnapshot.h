@@ -0,0 +1,118 @@
+/**
+ * @file   larcore/Geometry/GeometrySnapshot.h
+ * @brief  Immutable set of precomputed information about a loaded geometry.
+ *
+ * This library is header-only.
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYSNAPSHOT_H
+#define LARCORE_GEOMETRY_GEOMETRYSNAPSHOT_H
+
+// LArSoft libraries
+#include "larcore/Geometry/ChannelMapTable.h"
+#include "larcore/Geometry/OpticalChannelIndex.h"
+#include "larcore/Geometry/GeometrySpatialIndex.h"
+#include "larcore/Geometry/WireGeometryTable.h"
+#include "larcore/Geometry/GeometryIDTable.h"
+
+// C/C++ standard libraries
+#include <memory> // std::unique_ptr<>
+#include <string>
+#include <utility> // std::move()
+
+
+namespace geo {
+
+  /**
+   * @brief Information precomputed by `geo::Geometry` for a loaded geometry.
+   *
+   * A snapshot collects all the information that the geometry service derives
+   * from a geometry after loading it. It is created once for each loaded
+   * geometry and never modified afterwards.
+   *
+   * The geometry service publishes each new snapshot by atomically replacing
+   * the previous one (see `geo::Geometry::Snapshot()`): code holding a
+   * `std::shared_ptr` to a snapshot can keep using it safely, even while a
+   * new geometry is being loaded.
+   *
+   * Elements that were not configured to be computed are not available
+   * (null pointers).
+   *
+   * @note Snapshots may outlive the geometry description they were computed
+   *       from, and they may be reused when the same geometry is loaded again
+   *       (see `geo::GeometrySnapshotCache`): their content must never refer
+   *       to objects of `geo::GeometryCore` (like `geo::WireGeo`).
+   */
+  class GeometrySnapshot {
+
+      public:
+
+    /// Content of the snapshot.
+    struct Data_t {
+
+      /// Name of the detector the snapshot describes.
+      std::string detectorName;
+
+      /// Precomputed channel mapping.
+      std::unique_ptr<geo::ChannelMapTable const> channelTable;
+
+      /// Map of optical channels to optical detectors.
+      std::unique_ptr<geo::OpticalChannelIndex const> opChannelIndex;
+
+      /// Flat arrays of all the IDs and channels.
+      std::unique_ptr<geo::GeometryIDTable const> idTable;
+
+      /// Spatial index of cryostats and TPC.
+      std::unique_ptr<geo::GeometrySpatialIndex const> spatialIndex;
+
+      /// Geometry of all the wires, in flat arrays.
+      std::unique_ptr<geo::WireGeometryTable const> wireTable;
+
+    }; // Data_t
+
+
+    /// Constructor: an empty snapshot.
+    GeometrySnapshot() = default;
+
+    /// Constructor: takes ownership of the specified content.
+    explicit GeometrySnapshot(Data_t data): fData(std::move(data)) {}
+
+    // no copy, no move: the snapshot is shared via pointers
+    GeometrySnapshot(GeometrySnapshot const&) = delete;
+    GeometrySnapshot& operator= (GeometrySnapshot const&) = delete;
+
+    /// Returns the name of the detector the snapshot describes.
+    std::string const& DetectorName() const { return fData.detectorName; }
+
+    /// Returns the precomputed channel mapping (`nullptr` if not available).
+    geo::ChannelMapTable const* ChannelTable() const
+      { return fData.channelTable.get(); }
+
+    /// Returns the map of optical channels (`nullptr` if not available).
+    geo::OpticalChannelIndex const* OpChannelIndex() const
+      { return fData.opChannelIndex.get(); }
+
+    /// Returns the flat arrays of IDs and channels (`nullptr` if not
+    /// available).
+    geo::GeometryIDTable const* IDTable() const
+      { return fData.idTable.get(); }
+
+    /// Returns the spatial index of the volumes (`nullptr` if not available).
+    geo::GeometrySpatialIndex const* SpatialIndex() const
+      { return fData.spatialIndex.get(); }
+
+    /// Returns the flat wire geometry table (`nullptr` if not available).
+    geo::WireGeometryTable const* WireTable() const
+      { return fData.wireTable.get(); }
+
+
+      private:
+
+    Data_t fData; ///< Content of the snapshot.
+
+  }; // class GeometrySnapshot
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYSNAPSHOT_H
@@ -0,0 +1,41 @@
+/**
+ * @file   larcore/Geometry/GeometrySnapshotCache.cc
+ * @brief  Cache of the snapshots of the most recently used geometries.
+ * @see    larcore/Geometry/GeometrySnapshotCache.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometrySnapshotCache.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::find_if()
+
+
+//------------------------------------------------------------------------------
+auto geo::GeometrySnapshotCache::Find(std::string const& key) -> Snapshot_t {
+
+  auto const iEntry = std::find_if(fEntries.begin(), fEntries.end(),
+    [&key](auto const& entry){ return entry.first == key; });
+  if (iEntry == fEntries.end()) return nullptr;
+
+  // move the entry in front
+  fEntries.splice(fEntries.begin(), fEntries, iEntry);
+  return fEntries.front().second;
+
+} // geo::GeometrySnapshotCache::Find()
+
+
+//------------------------------------------------------------------------------
+void geo::GeometrySnapshotCache::Insert
+  (std::string const& key, Snapshot_t snapshot)
+{
+  if (fCapacity == 0) return;
+
+  fEntries.remove_if([&key](auto const& entry){ return entry.first == key; });
+  fEntries.emplace_front(key, std::move(snapshot));
+  while (fEntries.size() > fCapacity) fEntries.pop_back();
+
+} // geo::GeometrySnapshotCache::Insert()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,79 @@
+/**
+ * @file   larcore/Geometry/GeometrySnapshotCache.h
+ * @brief  Cache of the snapshots of the most recently used geometries.
+ * @see    larcore/Geometry/GeometrySnapshotCache.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYSNAPSHOTCACHE_H
+#define LARCORE_GEOMETRY_GEOMETRYSNAPSHOTCACHE_H
+
+// LArSoft libraries
+#include "larcore/Geometry/GeometrySnapshot.h"
+
+// C/C++ standard libraries
+#include <list>
+#include <memory> // std::shared_ptr<>
+#include <string>
+#include <utility> // std::pair<>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  /**
+   * @brief Keeps the snapshots of the last used geometries.
+   *
+   * Input files mixing runs from different detector configurations cause the
+   * geometry to be reloaded each time the configuration changes.
+   * This cache keeps the snapshots of the last `capacity()` geometries, so
+   * that switching back to one of them does not require recomputing its
+   * information. When the cache is full, the least recently used snapshot is
+   * dropped.
+   *
+   * The key identifying each geometry is chosen by the user, and it should
+   * include everything the content of the snapshot depends on.
+   *
+   * This object is not thread-safe.
+   */
+  class GeometrySnapshotCache {
+
+      public:
+
+    using Snapshot_t = std::shared_ptr<geo::GeometrySnapshot const>;
+
+    /// Constructor: keeps at most `capacity` snapshots (`0` disables cache).
+    explicit GeometrySnapshotCache(std::size_t capacity)
+      : fCapacity(capacity) {}
+
+    /**
+     * @brief Returns the snapshot with the specified key.
+     * @param key key of the snapshot
+     * @return the snapshot, or `nullptr` if not present
+     *
+     * The returned snapshot becomes the most recently used one.
+     */
+    Snapshot_t Find(std::string const& key);
+
+    /// Adds a snapshot as the most recently used one (replaces the same key).
+    void Insert(std::string const& key, Snapshot_t snapshot);
+
+    /// Returns the number of snapshots in the cache.
+    std::size_t size() const { return fEntries.size(); }
+
+    /// Returns the maximum number of snapshots in the cache.
+    std::size_t capacity() const { return fCapacity; }
+
+
+      private:
+
+    std::size_t fCapacity; ///< Maximum number of snapshots.
+
+    /// Cached snapshots, from the most recently used.
+    std::list<std::pair<std::string, Snapshot_t>> fEntries;
+
+  }; // class GeometrySnapshotCache
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYSNAPSHOTCACHE_H
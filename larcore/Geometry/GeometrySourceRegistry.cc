@@ -0,0 +1,95 @@
+/**
+ * @file   larcore/Geometry/GeometrySourceRegistry.cc
+ * @brief  Process-wide bookkeeping of the ROOT geometry shared by services.
+ * @see    larcore/Geometry/GeometrySourceRegistry.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometrySourceRegistry.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+// ROOT libraries
+#include "TGeoManager.h"
+
+
+//------------------------------------------------------------------------------
+geo::GeometrySourceRegistry& geo::GeometrySourceRegistry::Instance() {
+  static GeometrySourceRegistry registry;
+  return registry;
+} // geo::GeometrySourceRegistry::Instance()
+
+
+//------------------------------------------------------------------------------
+bool geo::GeometrySourceRegistry::UseSource
+  (std::string const& client, std::string const& sourceFile, Loader_t load)
+{
+  std::lock_guard<std::mutex> const lock { fMutex };
+
+  bool const import = needsImport(sourceFile);
+
+  load(import);
+
+  if (import) {
+    // importing destroyed the ROOT geometry the other clients were using
+    for (auto const& [ otherClient, otherSource ]: fClients) {
+      if (otherClient == client) continue;
+      mf::LogInfo("GeometrySourceRegistry")
+        << "'" << client << "' replaced the ROOT geometry from '"
+        << otherSource << "' with the one from '" << sourceFile
+        << "': '" << otherClient << "' needs to load its geometry again.";
+      fStaleClients[otherClient] = otherSource;
+    } // for
+    fClients.clear();
+    fCurrentSource = sourceFile;
+    fManager = gGeoManager;
+  }
+  else {
+    mf::LogInfo("GeometrySourceRegistry")
+      << "'" << client << "' shares the ROOT geometry from '" << sourceFile
+      << "' already loaded in memory.";
+  }
+
+  fClients[client] = sourceFile;
+  fStaleClients.erase(client);
+  return import;
+} // geo::GeometrySourceRegistry::UseSource()
+
+
+//------------------------------------------------------------------------------
+std::string geo::GeometrySourceRegistry::CurrentSource() const {
+  std::lock_guard<std::mutex> const lock { fMutex };
+  return fCurrentSource;
+} // geo::GeometrySourceRegistry::CurrentSource()
+
+
+//------------------------------------------------------------------------------
+bool geo::GeometrySourceRegistry::IsUsing
+  (std::string const& client, std::string const& sourceFile) const
+{
+  std::lock_guard<std::mutex> const lock { fMutex };
+  if (!gGeoManager || (gGeoManager != fManager)) return false;
+  auto const iClient = fClients.find(client);
+  return (iClient != fClients.end()) && (iClient->second == sourceFile);
+} // geo::GeometrySourceRegistry::IsUsing()
+
+
+//------------------------------------------------------------------------------
+bool geo::GeometrySourceRegistry::IsStale(std::string const& client) const {
+  std::lock_guard<std::mutex> const lock { fMutex };
+  return fStaleClients.count(client) > 0;
+} // geo::GeometrySourceRegistry::IsStale()
+
+
+//------------------------------------------------------------------------------
+bool geo::GeometrySourceRegistry::needsImport
+  (std::string const& sourceFile) const
+{
+  if (!gGeoManager) return true; // no geometry at all yet
+  if (gGeoManager != fManager) return true; // not imported via the registry
+  return sourceFile != fCurrentSource;
+} // geo::GeometrySourceRegistry::needsImport()
+
+
+//------------------------------------------------------------------------------
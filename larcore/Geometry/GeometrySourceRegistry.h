@@ -0,0 +1,129 @@
+/**
+ * @file   larcore/Geometry/GeometrySourceRegistry.h
+ * @brief  Process-wide bookkeeping of the ROOT geometry shared by services.
+ * @see    larcore/Geometry/GeometrySourceRegistry.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYSOURCEREGISTRY_H
+#define LARCORE_GEOMETRY_GEOMETRYSOURCEREGISTRY_H
+
+// C/C++ standard libraries
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+
+class TGeoManager;
+
+namespace geo {
+
+  /**
+   * @brief Keeps track of which geometry file the ROOT geometry comes from.
+   *
+   * ROOT keeps a single geometry per process (`gGeoManager`), which is shared
+   * by all the services describing the detector (`geo::Geometry` and
+   * `geo::AuxDetGeometry`). Each of them used to decide independently
+   * whether to import a new ROOT geometry: a service would either parse
+   * again the same file another service had already loaded, or reuse a ROOT
+   * geometry loaded from a different file.
+   *
+   * This registry records which file the current ROOT geometry was imported
+   * from, and which services (_clients_) use it. A client loading a geometry
+   * from a file calls `UseSource()`, which tells it whether the ROOT geometry
+   * needs to be imported: that happens only if there is no ROOT geometry
+   * yet, or if it comes from a different file, or if it was imported by code
+   * not using this registry. A file used by two services is then parsed
+   * only once.
+   *
+   * Importing a new ROOT geometry destroys the one the other clients are
+   * using, leaving their objects pointing to deleted ROOT volumes: those
+   * clients are then marked as _stale_ (`IsStale()`), and they must load
+   * their geometry again before it is used, from the new source. This
+   * happens for example when the detector changes between runs: the first
+   * service reacting to the new run imports the new file, and the others
+   * load it in turn (without importing it again). Services check whether
+   * they are stale on each new run (`sPreBeginRun`); a stale client can't
+   * keep a geometry from a different file, since ROOT supports a single
+   * geometry per process.
+   *
+   * All the operations are serialized.
+   */
+  class GeometrySourceRegistry {
+
+      public:
+
+    /// Type of function loading the geometry; the argument tells whether
+    /// ROOT geometry needs to be imported.
+    using Loader_t = std::function<void(bool importROOTgeometry)>;
+
+    /// Returns the registry of this process.
+    static GeometrySourceRegistry& Instance();
+
+    /**
+     * @brief Loads the geometry of `client` from the specified source.
+     * @param client name of the service loading the geometry
+     * @param sourceFile full path of the ROOT geometry file
+     * @param load function performing the loading
+     * @return whether the ROOT geometry was imported anew
+     *
+     * The function `load` is called while holding the registry lock,
+     * with `true` argument if the ROOT geometry must be imported from
+     * `sourceFile`. If `load` throws an exception, the source is not
+     * registered. If the ROOT geometry is imported, all the other clients
+     * become stale.
+     */
+    bool UseSource
+      (std::string const& client, std::string const& sourceFile, Loader_t load);
+
+    /// Returns the file the current ROOT geometry was imported from.
+    std::string CurrentSource() const;
+
+    /**
+     * @brief Returns whether `client` still uses the ROOT geometry from
+     *        `sourceFile`.
+     *
+     * This is `false` if the ROOT geometry was replaced after `client` loaded
+     * its geometry, in which case the objects of `client` refer to a stale
+     * ROOT geometry.
+     */
+    bool IsUsing(std::string const& client, std::string const& sourceFile)
+      const;
+
+    /**
+     * @brief Returns whether another client replaced the ROOT geometry
+     *        `client` was using.
+     *
+     * The client stops being stale when it loads its geometry again
+     * with `UseSource()`.
+     */
+    bool IsStale(std::string const& client) const;
+
+
+      private:
+
+    mutable std::mutex fMutex; ///< Serializes all operations.
+
+    /// File the current ROOT geometry was imported from.
+    std::string fCurrentSource;
+
+    /// ROOT geometry manager imported from `fCurrentSource`.
+    TGeoManager const* fManager = nullptr;
+
+    /// Source used by each client.
+    std::map<std::string, std::string> fClients;
+
+    /// Clients whose ROOT geometry was replaced, with their old source.
+    std::map<std::string, std::string> fStaleClients;
+
+    GeometrySourceRegistry() = default;
+
+    /// Returns whether ROOT geometry must be imported to use `sourceFile`.
+    bool needsImport(std::string const& sourceFile) const;
+
+  }; // class GeometrySourceRegistry
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYSOURCEREGISTRY_H
@@ -0,0 +1,123 @@
+/**
+ * @file   larcore/Geometry/GeometrySpatialIndex.cc
+ * @brief  Spatial index for the location of points in cryostats and TPC.
+ * @see    larcore/Geometry/GeometrySpatialIndex.h
+ */
+
+// library header
+#include "larcore/Geometry/GeometrySpatialIndex.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+
+
+namespace {
+
+  /// Returns the box of `volume`, enlarged as `ContainsPosition()` does.
+  template <typename Volume>
+  geo::UniformGridIndex::Box_t wiggledBox
+    (Volume const& volume, double wiggle)
+  {
+    // same as geo::BoxBoundedGeo::CoordinateContained()
+    auto wiggledMin = [wiggle](double min)
+      { return (min > 0.0)? (min / wiggle): (min * wiggle); };
+    auto wiggledMax = [wiggle](double max)
+      { return (max < 0.0)? (max / wiggle): (max * wiggle); };
+    return {
+      {{
+        wiggledMin(volume.MinX()), wiggledMin(volume.MinY()),
+        wiggledMin(volume.MinZ())
+      }},
+      {{
+        wiggledMax(volume.MaxX()), wiggledMax(volume.MaxY()),
+        wiggledMax(volume.MaxZ())
+      }}
+      };
+  } // wiggledBox()
+
+
+  /// Returns the first ID in `candidates` satisfying `contains`.
+  template <typename ID, typename Candidates, typename Contains>
+  ID firstContaining
+    (std::vector<ID> const& IDs, Candidates const& candidates, Contains contains)
+  {
+    for (std::size_t index: candidates)
+      if (contains(IDs[index])) return IDs[index];
+    return {};
+  } // firstContaining()
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+geo::GeometrySpatialIndex::GeometrySpatialIndex
+  (geo::GeometryCore const& geom, double maxWiggle)
+  : fMaxWiggle(maxWiggle)
+{
+  std::vector<geo::UniformGridIndex::Box_t> boxes;
+
+  for (geo::CryostatGeo const& cryo: geom.IterateCryostats()) {
+    fCryostatIDs.push_back(cryo.ID());
+    boxes.push_back(wiggledBox(cryo, fMaxWiggle));
+  }
+  fCryostatGrid = geo::UniformGridIndex{ boxes };
+
+  boxes.clear();
+  for (geo::TPCGeo const& tpc: geom.IterateTPCs()) {
+    fTPCIDs.push_back(tpc.ID());
+    boxes.push_back(wiggledBox(tpc, fMaxWiggle));
+  }
+  fTPCgrid = geo::UniformGridIndex{ boxes };
+
+} // geo::GeometrySpatialIndex::GeometrySpatialIndex()
+
+
+//------------------------------------------------------------------------------
+geo::CryostatID geo::GeometrySpatialIndex::PositionToCryostatID(
+  geo::GeometryCore const& geom, geo::Point_t const& point, double wiggle
+) const {
+
+  auto contains = [&geom, &point, wiggle](geo::CryostatID const& cid)
+    { return geom.Cryostat(cid).ContainsPosition(point, wiggle); };
+
+  if (wiggle > fMaxWiggle) { // not supported by the grid: test all of them
+    std::vector<std::size_t> all(fCryostatIDs.size());
+    for (std::size_t i = 0; i < all.size(); ++i) all[i] = i;
+    return firstContaining(fCryostatIDs, all, contains);
+  }
+
+  return firstContaining(fCryostatIDs,
+    fCryostatGrid.Candidates(point.X(), point.Y(), point.Z()), contains);
+
+} // geo::GeometrySpatialIndex::PositionToCryostatID()
+
+
+//------------------------------------------------------------------------------
+geo::TPCID geo::GeometrySpatialIndex::PositionToTPCID(
+  geo::GeometryCore const& geom, geo::Point_t const& point, double wiggle
+) const {
+
+  geo::CryostatID const cid = PositionToCryostatID(geom, point, wiggle);
+  if (!cid) return {};
+
+  auto contains = [&geom, &point, wiggle, &cid](geo::TPCID const& tpcid)
+    {
+      return (tpcid.asCryostatID() == cid)
+        && geom.TPC(tpcid).ContainsPosition(point, wiggle);
+    };
+
+  if (wiggle > fMaxWiggle) { // not supported by the grid: test all of them
+    std::vector<std::size_t> all(fTPCIDs.size());
+    for (std::size_t i = 0; i < all.size(); ++i) all[i] = i;
+    return firstContaining(fTPCIDs, all, contains);
+  }
+
+  return firstContaining(fTPCIDs,
+    fTPCgrid.Candidates(point.X(), point.Y(), point.Z()), contains);
+
+} // geo::GeometrySpatialIndex::PositionToTPCID()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,103 @@
+/**
+ * @file   larcore/Geometry/GeometrySpatialIndex.h
+ * @brief  Spatial index for the location of points in cryostats and TPC.
+ * @see    larcore/Geometry/GeometrySpatialIndex.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_GEOMETRYSPATIALINDEX_H
+#define LARCORE_GEOMETRY_GEOMETRYSPATIALINDEX_H
+
+// LArSoft libraries
+#include "larcore/Geometry/UniformGridIndex.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_vectors.h" // geo::Point_t
+
+// C/C++ standard libraries
+#include <vector>
+
+
+namespace geo {
+
+  class GeometryCore;
+
+  /**
+   * @brief Finds the cryostat and TPC containing a point, via spatial index.
+   *
+   * `geo::GeometryCore::PositionToTPCID()` and
+   * `geo::GeometryCore::PositionToCryostatID()` test the volumes one by one.
+   * This object places the cryostats and the TPC in uniform grids
+   * (`geo::UniformGridIndex`), so that only the few volumes overlapping the
+   * grid cell of the point need to be tested.
+   *
+   * The final test on each candidate volume is performed by the volume itself
+   * (`ContainsPosition()`), in the same order and with the same tolerance
+   * ("wiggle") as `geo::GeometryCore`, so that the answers are the same.
+   * The grids are built including the largest tolerance that can be used
+   * in the queries (`MaxWiggle()`); queries with a larger tolerance fall back
+   * to testing all the volumes.
+   *
+   * The index stores only volume IDs, so it stays valid for as long as the
+   * same geometry is loaded; for the same reason, the queries require the
+   * geometry itself.
+   */
+  class GeometrySpatialIndex {
+
+      public:
+
+    /// Constructor: an empty index.
+    GeometrySpatialIndex() = default;
+
+    /**
+     * @brief Constructor: indexes all the cryostats and TPC of `geom`.
+     * @param geom the geometry to be indexed
+     * @param maxWiggle largest relative tolerance to be supported
+     */
+    GeometrySpatialIndex(geo::GeometryCore const& geom, double maxWiggle);
+
+    /// Returns the largest tolerance supported by the index.
+    double MaxWiggle() const { return fMaxWiggle; }
+
+    /**
+     * @brief Returns the ID of the cryostat containing `point`.
+     * @param geom the geometry the index was built from
+     * @param point the point to be located [cm]
+     * @param wiggle relative tolerance (as in `ContainsPosition()`)
+     * @return the ID of the cryostat, invalid if none contains `point`
+     * @see geo::GeometryCore::PositionToCryostatID()
+     */
+    geo::CryostatID PositionToCryostatID(
+      geo::GeometryCore const& geom, geo::Point_t const& point, double wiggle
+      ) const;
+
+    /**
+     * @brief Returns the ID of the TPC containing `point`.
+     * @param geom the geometry the index was built from
+     * @param point the point to be located [cm]
+     * @param wiggle relative tolerance (as in `ContainsPosition()`)
+     * @return the ID of the TPC, invalid if none contains `point`
+     * @see geo::GeometryCore::PositionToTPCID()
+     *
+     * As in `geo::GeometryCore`, only the TPC within the first cryostat
+     * containing the point are considered.
+     */
+    geo::TPCID PositionToTPCID(
+      geo::GeometryCore const& geom, geo::Point_t const& point, double wiggle
+      ) const;
+
+
+      private:
+
+    double fMaxWiggle = 1.0; ///< Largest supported tolerance.
+
+    geo::UniformGridIndex fCryostatGrid; ///< Grid of cryostat volumes.
+    std::vector<geo::CryostatID> fCryostatIDs; ///< IDs of indexed cryostats.
+
+    geo::UniformGridIndex fTPCgrid; ///< Grid of TPC volumes.
+    std::vector<geo::TPCID> fTPCIDs; ///< IDs of indexed TPC.
+
+  }; // class GeometrySpatialIndex
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_GEOMETRYSPATIALINDEX_H
@@ -12,15 +12,32 @@
 #include "larcorealg/Geometry/GeometryBuilderStandard.h"
 #include "larcoreobj/SummaryData/RunData.h"
 #include "larcore/Geometry/ExptGeoHelperInterface.h"
+#include "larcore/Geometry/ChannelMapSetupTool.h"
+#include "larcore/Geometry/GeometrySourceRegistry.h"
+#include "larcore/Geometry/GeometryFileLocator.h"
+#include "larcore/Geometry/GDMLPreloader.h"
+#include "larcore/Geometry/GeometryBuilderSyntheticWires.h"
 
 // Framework includes
 #include "fhiclcpp/types/Table.h"
+#include "art/Utilities/make_tool.h"
+#include "art/Persistency/Provenance/ModuleContext.h"
+#include "art/Persistency/Provenance/ModuleDescription.h"
 #include "cetlib_except/exception.h"
-#include "cetlib/search_path.h"
 #include "messagefacility/MessageLogger/MessageLogger.h"
 
+// ROOT libraries
+#include "TMath.h" // TMath::DegToRad()
+
+// TBB libraries
+#include "tbb/task_group.h"
+#include "tbb/task_arena.h" // tbb::this_task_arena::isolate()
+
 // C/C++ standard libraries
+#include <memory> // std::make_unique()
+#include <sstream>
 #include <string>
+#include <vector>
 
 // check that the requirements for geo::Geometry are satisfied
 template struct lar::details::ServiceRequirementsChecker<geo::Geometry>;
@@ -36,13 +53,83 @@ namespace geo {
     , fForceUseFCLOnly  (pset.get< bool              >("ForceUseFCLOnly" , false))
     , fSortingParameters(pset.get<fhicl::ParameterSet>("SortingParameters", fhicl::ParameterSet() ))
     , fBuilderParameters(pset.get<fhicl::ParameterSet>("Builder",          fhicl::ParameterSet() ))
+    , fChannelMappingConfig(pset.get<fhicl::ParameterSet>("ChannelMapping", {}))
+    , fSyntheticWiresConfig(pset.get<fhicl::ParameterSet>("SyntheticWires", {}))
+    , fBuildChannelMapTable(pset.get<bool>("BuildChannelMapTable", false))
+    , fBuildWireGeometryTable(pset.get<bool>("BuildWireGeometryTable", false))
+    , fParallelInitialization(pset.get<bool>("ParallelInitialization", false))
+    , fPreloadGDML(pset.get<bool>("PreloadGDML", false))
+    , fSnapshot(std::make_shared<geo::GeometrySnapshot const>())
+    , fSnapshotCache(pset.get<unsigned int>("GeometryHistorySize", 2U))
+    , fLazyLoading      (pset.get< bool              >("LazyLoading",      false))
+    , fProfiler("GeometryProfile", pset.get<bool>("ProfileLoading", false))
   {
     // add a final directory separator ("/") to fRelPath if not already there
     if (!fRelPath.empty() && (fRelPath.back() != '/')) fRelPath += '/';
 
+    for (auto const& plane: fSyntheticWiresConfig
+      .get<std::vector<fhicl::ParameterSet>>("Planes", {}))
+    {
+      geo::GeometryBuilderSyntheticWires::PlaneLayout_t layout;
+      layout.volumeName = plane.get<std::string>("Volume");
+      layout.pitch = plane.get<double>("Pitch");
+      layout.angle = plane.get<double>("Angle") * TMath::DegToRad();
+      layout.offset = plane.get<double>("Offset", layout.pitch);
+      layout.wireRadius = plane.get<double>("WireRadius");
+      fSyntheticWirePlanes.push_back(std::move(layout));
+    } // for
+
+    std::string const manifestPath
+      = pset.get<std::string>("ResolvedPathManifest", "");
+    if (!manifestPath.empty())
+      geo::GeometryFileLocator::Instance().UseManifest(manifestPath);
+
+    if (pset.get<bool>("UseGeometryCache", false)) {
+      fGeometryCache = std::make_unique<geo::GeometryCache>(
+        pset.get<std::string>("GeometryCacheDirectory", ""),
+        pset.get<bool>       ("UpdateGeometryCache",    true)
+        );
+    }
+
+    std::string const sharedTableDir
+      = pset.get<std::string>("SharedChannelMapDirectory", "");
+    if (!sharedTableDir.empty() && fBuildChannelMapTable) {
+      fChannelMapImage = std::make_unique<geo::ChannelMapImage>(sharedTableDir);
+    }
+    else if (!sharedTableDir.empty()) {
+      mf::LogWarning("Geometry") << "`SharedChannelMapDirectory` ('"
+        << sharedTableDir << "') is ignored, since the channel mapping tables"
+        " are not built (`BuildChannelMapTable` is not set)";
+    }
+
     // register a callback to be executed when a new run starts
     reg.sPreBeginRun.watch(this, &Geometry::preBeginRun);
 
+    // in lazy mode, modules reaching the geometry directly through
+    // `art::ServiceHandle` must not find it empty
+    if (fLazyLoading) {
+      for (auto const& label: pset.get<std::vector<std::string>>
+        ("LazyLoadingIgnoredModules", {})
+        )
+      {
+        fLazyLoadingIgnoredModules.insert(label);
+      }
+      reg.sPreModuleConstruction.watch(this, &Geometry::preModuleConstruction);
+    }
+
+    // query counters, with attribution of the queries to the running module
+    if (pset.get<bool>("CountQueries", false)) {
+      fQueryCounters = std::make_unique<geo::GeometryQueryCounters>
+        (pset.get<unsigned int>("QuerySamplingPeriod", 0U));
+      reg.sPreModule.watch(this, &Geometry::preModule);
+      reg.sPostModule.watch(this, &Geometry::postModule);
+      reg.sPreModuleBeginRun.watch(this, &Geometry::preModule);
+      reg.sPostModuleBeginRun.watch(this, &Geometry::postModule);
+    }
+
+    if (fProfiler.enabled() || fQueryCounters)
+      reg.sPostEndJob.watch(this, &Geometry::postEndJob);
+
     //......................................................................
     // 5.15.12 BJR: use the gdml file for both the fGDMLFile and fROOTFile
     // variables as ROOT v5.30.06 is once again able to read in gdml files
@@ -52,19 +139,28 @@ namespace geo {
     std::string GDMLFileName = pset.get<std::string>("GDML");
     std::string ROOTFileName = pset.get<std::string>("GDML");
 
-    // load the geometry
+    // load the geometry (in lazy mode, just locate it)
     LoadNewGeometry(GDMLFileName, ROOTFileName);
 
   } // Geometry::Geometry()
 
 
   void Geometry::preBeginRun(art::Run const& run)
+  {
+    // if the detector has not changed, the geometry may still need a rebuild
+    // because of a new ROOT geometry imported by another service
+    if (!LoadRunGeometry(run)) ReloadIfStale();
+  } // Geometry::preBeginRun()
+
+
+  //......................................................................
+  bool Geometry::LoadRunGeometry(art::Run const& run)
   {
     // FIXME this seems utterly wrong: constructor loads geometry based on an
     // explicit parameter, whereas here we load it by detector name
 
     // if we are requested to stick to the configured geometry, do nothing
-    if (fForceUseFCLOnly) return;
+    if (fForceUseFCLOnly) return false;
 
     // check here to see if we need to load a new geometry.
     // get the detector id from the run object
@@ -74,12 +170,12 @@ namespace geo {
       mf::LogWarning("Geometry") << "cannot find sumdata::RunData object to grab detector name\n"
                                  << "this is expected if generating MC files\n"
                                  << "using default geometry from configuration file\n";
-      return;
+      return false;
     }
 
     // if the detector name is still the same, everything is fine
     auto const& newDetectorName = rdcol.front()->DetName();
-    if (DetectorName() == newDetectorName) return;
+    if (DetectorName() == newDetectorName) return false;
 
     // check to see if the detector name in the RunData
     // object has not been set.
@@ -92,8 +188,82 @@ namespace geo {
       SetDetectorName(newDetectorName);
     }
 
-    LoadNewGeometry(newDetectorName + ".gdml", newDetectorName + ".gdml", true);
-  } // Geometry::preBeginRun()
+    LoadNewGeometry(newDetectorName + ".gdml", newDetectorName + ".gdml");
+    return true;
+  } // Geometry::LoadRunGeometry()
+
+
+  //......................................................................
+  void Geometry::ReloadIfStale()
+  {
+    auto const& registry = geo::GeometrySourceRegistry::Instance();
+    if (!registry.IsStale("Geometry")) return;
+
+    std::lock_guard<std::mutex> const lock{ fLoadMutex };
+
+    // a pending lazy loading will find the new ROOT geometry by itself
+    if (fLazyLoading && !fLoaded.load(std::memory_order_relaxed)) return;
+
+    // importing our file again would make the other service stale in turn
+    GeometryFiles_t const files = fCurrentGeometry;
+    if (registry.CurrentSource() != files.ROOTfile) {
+      throw cet::exception("Geometry")
+        << "The ROOT geometry was replaced with the one from '"
+        << registry.CurrentSource() << "', while this service is configured"
+        " to use '" << files.ROOTfile << "'; ROOT supports a single geometry"
+        " per process, so all the services must use the same file.\n";
+    }
+    mf::LogInfo("Geometry") << "Rebuilding the geometry of '"
+      << DetectorName() << "' on the ROOT geometry loaded by another service";
+    LoadGeometryFiles(files);
+  } // Geometry::ReloadIfStale()
+
+
+  //......................................................................
+  void Geometry::postEndJob()
+  {
+    if (fProfiler.enabled()) {
+      std::ostringstream summary;
+      fProfiler.PrintSummary(summary, "  ");
+      mf::LogInfo("GeometryProfile")
+        << "Geometry loading profile summary:\n" << summary.str();
+    }
+    if (fQueryCounters) {
+      std::ostringstream summary;
+      fQueryCounters->PrintSummary(summary, "  ");
+      mf::LogInfo("GeometryQueries") << "Geometry queries by module"
+        " (module;query;calls;timed calls;mean time [ns]):\n"
+        << summary.str();
+    }
+  } // Geometry::postEndJob()
+
+
+  //......................................................................
+  void Geometry::preModuleConstruction(art::ModuleDescription const& module)
+  {
+    // framework modules which do not use the geometry
+    static std::set<std::string> const FrameworkModules
+      { "RootOutput", "TriggerResultInserter" };
+
+    if (fLoaded.load(std::memory_order_acquire)) return;
+    if (fLazyLoadingIgnoredModules.count(module.moduleLabel()) > 0) return;
+    if (FrameworkModules.count(module.moduleName()) > 0) return;
+
+    mf::LogInfo("Geometry") << "Loading the geometry before the construction"
+      " of module '" << module.moduleLabel() << "' (" << module.moduleName()
+      << "), which may use it";
+    EnsureLoaded();
+  } // Geometry::preModuleConstruction()
+
+
+  //......................................................................
+  void Geometry::preModule(art::ModuleContext const& context)
+    { fQueryCounters->EnterModule(context.moduleLabel()); }
+
+
+  //......................................................................
+  void Geometry::postModule(art::ModuleContext const&)
+    { fQueryCounters->LeaveModule(); }
 
 
   //......................................................................
@@ -101,21 +271,148 @@ namespace geo {
   {
     // the channel map is responsible of calling the channel map configuration
     // of the geometry
-    art::ServiceHandle<geo::ExptGeoHelperInterface const> helper{};
-    auto channelMapAlg = helper->ConfigureChannelMapAlg(fSortingParameters,
-                                                        DetectorName());
+    auto configTimer = fProfiler.Step("channel mapping configuration");
+    auto channelMapAlg = MakeChannelMapAlg();
     if (!channelMapAlg) {
       throw cet::exception("ChannelMapLoadFail")
         << " failed to load new channel map";
     }
+    configTimer.stop();
+
+    auto applyTimer = fProfiler.Step("channel mapping application");
+    fChannelMapAlg = channelMapAlg.get();
     ApplyChannelMap(move(channelMapAlg));
   } // Geometry::InitializeChannelMap()
 
   //......................................................................
-  void Geometry::LoadNewGeometry(
-    std::string gdmlfile, std::string /* rootfile */,
-    bool bForceReload /* = false */
-  ) {
+  std::unique_ptr<geo::ChannelMapAlg> Geometry::MakeChannelMapAlg() const
+  {
+    if (fChannelMappingConfig.is_empty()) {
+      art::ServiceHandle<geo::ExptGeoHelperInterface const> helper{};
+      return
+        helper->ConfigureChannelMapAlg(fSortingParameters, DetectorName());
+    }
+
+    // tools may not support repeated calls: use a new one for each geometry
+    auto channelMapSetup
+      = art::make_tool<geo::ChannelMapSetupTool>(fChannelMappingConfig);
+    mf::LogInfo("Geometry") << "Loading channel mapping from tool '"
+      << fChannelMappingConfig.get<std::string>("tool_type") << "'";
+    return channelMapSetup->setupChannelMap();
+  } // Geometry::MakeChannelMapAlg()
+
+  //......................................................................
+  std::shared_ptr<geo::GeometrySnapshot const> Geometry::MakeSnapshot() const
+  {
+    auto timer = fProfiler.Step("precomputed information");
+    geo::GeometrySnapshot::Data_t data;
+    data.detectorName = DetectorName();
+    if (fBuildChannelMapTable) data.channelTable = MakeChannelMapTable();
+    if (fBuildWireGeometryTable)
+      data.wireTable = std::make_unique<geo::WireGeometryTable>(*this);
+    data.idTable = std::make_unique<geo::GeometryIDTable>(*this);
+    data.opChannelIndex = std::make_unique<geo::OpticalChannelIndex>(*this);
+    data.spatialIndex = std::make_unique<geo::GeometrySpatialIndex>
+      (*this, 1.0 + DefaultWiggle());
+    return std::make_shared<geo::GeometrySnapshot const>(std::move(data));
+  } // Geometry::MakeSnapshot()
+
+  //......................................................................
+  std::string Geometry::SnapshotKey(GeometryFiles_t const& files) const
+  {
+    // the snapshot depends on the geometry and on the channel mapping
+    return DetectorName()
+      + '|' + files.ROOTfile
+      + '|' + fBuilderParameters.id().to_string()
+      + '|' + fSortingParameters.id().to_string()
+      + '|' + fChannelMappingConfig.id().to_string()
+      + '|' + fSyntheticWiresConfig.id().to_string();
+  } // Geometry::SnapshotKey()
+
+  //......................................................................
+  std::string Geometry::DescriptionKey(GeometryFiles_t const& files) const
+  {
+    return files.ROOTfile + '|' + fBuilderParameters.id().to_string()
+      + '|' + fSyntheticWiresConfig.id().to_string();
+  } // Geometry::DescriptionKey()
+
+  //......................................................................
+  std::string Geometry::ChannelMapSourceKey() const
+  {
+    // a channel mapping tool is identified by its configuration already
+    if (!fChannelMappingConfig.is_empty()) return {};
+    art::ServiceHandle<geo::ExptGeoHelperInterface const> helper{};
+    return helper->ConfigurationKey();
+  } // Geometry::ChannelMapSourceKey()
+
+  //......................................................................
+  std::unique_ptr<geo::ChannelMapTable const>
+  Geometry::MakeChannelMapTable() const
+  {
+    if (!fChannelMapImage) {
+      return
+        std::make_unique<geo::ChannelMapTable>(*this, fParallelInitialization);
+    }
+
+    // the tables may have been published already by another process
+    std::string const& sourceFile = fCurrentGeometry.ROOTfile;
+    std::string const& key = fCurrentGeometry.cacheKey;
+    if (auto table = fChannelMapImage->Map(*this, sourceFile, key))
+      return table;
+
+    // if not, build them, publish them, and use the published ones
+    auto table
+      = std::make_unique<geo::ChannelMapTable>(*this, fParallelInitialization);
+    if (fChannelMapImage->Publish(*table, sourceFile, key)) {
+      if (auto shared = fChannelMapImage->Map(*this, sourceFile, key))
+        return shared;
+    }
+    return table;
+  } // Geometry::MakeChannelMapTable()
+
+  //......................................................................
+  void Geometry::LoadNewGeometry
+    (std::string gdmlfile, std::string /* rootfile */)
+  {
+    auto searchTimer = fProfiler.Step("files search");
+    GeometryFiles_t files = LocateGeometryFiles(gdmlfile);
+    searchTimer.stop();
+
+    std::lock_guard<std::mutex> const lock{ fLoadMutex };
+
+    // in lazy mode, if the geometry has not been used yet, just take note
+    if (fLazyLoading && !fLoaded.load(std::memory_order_relaxed)) {
+      fPendingGeometry = std::move(files);
+      mf::LogInfo("Geometry") << "Loading of geometry from '"
+        << fPendingGeometry.ROOTfile << "' deferred until its first use.";
+      return;
+    }
+
+    LoadGeometryFiles(files);
+    fLoaded.store(true, std::memory_order_release);
+
+  } // Geometry::LoadNewGeometry()
+
+  //......................................................................
+  void Geometry::EnsureLoaded() const
+  {
+    if (fLoaded.load(std::memory_order_acquire)) return;
+
+    std::lock_guard<std::mutex> const lock{ fLoadMutex };
+    if (fLoaded.load(std::memory_order_relaxed)) return; // loaded meanwhile
+
+    // the service provider is conceptually unchanged by its initialization
+    auto& self = const_cast<Geometry&>(*this);
+    self.LoadGeometryFiles(fPendingGeometry);
+    self.fPendingGeometry = {};
+    fLoaded.store(true, std::memory_order_release);
+
+  } // Geometry::EnsureLoaded()
+
+  //......................................................................
+  Geometry::GeometryFiles_t Geometry::LocateGeometryFiles
+    (std::string const& gdmlfile) const
+  {
     // start with the relative path
     std::string GDMLFileName(fRelPath), ROOTFileName(fRelPath);
 
@@ -127,40 +424,173 @@ namespace geo {
     if(fDisableWiresInG4)
       GDMLFileName.insert(GDMLFileName.find(".gdml"), "_nowires");
 
+    // the ROOT geometry has no wires if they are synthesized
+    if (!fSyntheticWirePlanes.empty())
+      ROOTFileName.insert(ROOTFileName.find(".gdml"), "_nowires");
+
     // Search all reasonable locations for the GDML file that contains
-    // the detector geometry.
-    // cet::search_path constructor decides if initialized value is a path
-    // or an environment variable
-    cet::search_path const sp{"FW_SEARCH_PATH"};
+    // the detector geometry; the search results are shared within the
+    // process, and GDML and ROOT files, usually the same, are searched once
+    geo::GeometryFileLocator& locator = geo::GeometryFileLocator::Instance();
+
+    GeometryFiles_t files;
+    bool foundGDML = false, foundROOT = false;
+
+    // the ROOT file search and the snapshot key (which requires reading the
+    // whole file) are independent of the search of the GDML file;
+    // if a binary snapshot of this geometry is available, ROOT loads that one
+    auto findROOTsource = [&](){
+      foundROOT = locator.FindFile(ROOTFileName, files.ROOTfile);
+      if (!foundROOT || (!fGeometryCache && !fChannelMapImage)) return;
+      // the ROOT geometry does not depend on the configuration,
+      // its derived information does
+      files.descriptionKey = geo::GeometryCache::CacheKey(files.ROOTfile, {});
+      files.cacheKey = geo::GeometryCache::ExtendKey(
+        files.descriptionKey + '|' + ChannelMapSourceKey(),
+        { fBuilderParameters, fSortingParameters, fChannelMappingConfig,
+          fSyntheticWiresConfig });
+      if (fGeometryCache) {
+        files.snapshotFile = fGeometryCache->FindSnapshot
+          (files.ROOTfile, files.descriptionKey);
+      }
+    };
+
+    if (fParallelInitialization) {
+      // isolated, since the caller may hold the loading lock
+      tbb::this_task_arena::isolate([&](){
+        tbb::task_group searches;
+        searches.run([&](){
+          foundGDML = locator.FindFile(GDMLFileName, files.GDMLfile);
+        });
+        findROOTsource();
+        searches.wait();
+      });
+    }
+    else {
+      foundGDML = locator.FindFile(GDMLFileName, files.GDMLfile);
+      findROOTsource();
+    }
 
-    std::string GDMLfile;
-    if( !sp.find_file(GDMLFileName, GDMLfile) ) {
+    if( !foundGDML ) {
       throw cet::exception("Geometry")
         << "cannot find the gdml geometry file:"
         << "\n" << GDMLFileName
         << "\nbail ungracefully.\n";
     }
 
-    std::string ROOTfile;
-    if( !sp.find_file(ROOTFileName, ROOTfile) ) {
+    if( !foundROOT ) {
       throw cet::exception("Geometry")
         << "cannot find the root geometry file:\n"
         << "\n" << ROOTFileName
         << "\nbail ungracefully.\n";
     }
 
-    {
+    return files;
+  } // Geometry::LocateGeometryFiles()
+
+  //......................................................................
+  void Geometry::PreloadGeometryFile(std::string const& path) const
+  {
+    auto timer = fProfiler.Step("GDML preloading");
+    geo::GDMLPreloader::Summary_t const summary
+      = geo::GDMLPreloader{}.Preload(path);
+    timer.stop();
+    mf::LogInfo("Geometry") << "Preloaded '" << path << "' (" << summary.size
+      << " bytes in " << summary.nChunks << " chunks): " << summary.nTubes
+      << " tubes, " << summary.nVolumes << " volumes, " << summary.nPhysVols
+      << " physical volumes";
+  } // Geometry::PreloadGeometryFile()
+
+  //......................................................................
+  void Geometry::LoadGeometryFiles
+    (GeometryFiles_t const& files)
+  {
+    auto timer = fProfiler.Step("total loading");
+
+    // the geometry description is reused if built from the same input and
+    // still referring to the current ROOT geometry
+    std::string const descriptionKey = DescriptionKey(files);
+    bool const sameDescription = (descriptionKey == fLoadedDescription)
+      && geo::GeometrySourceRegistry::Instance()
+        .IsUsing("Geometry", files.ROOTfile);
+
+    bool const fromSnapshot = !sameDescription && !files.snapshotFile.empty();
+    if (fromSnapshot) {
+      mf::LogInfo("Geometry")
+        << "Loading ROOT geometry from snapshot '" << files.snapshotFile << "'";
+    }
+
+    // the same description is loaded again when the detector name changes
+    // but its geometry file does not (e.g. "bo" and "longbo")
+    if (sameDescription) {
+      mf::LogInfo("Geometry") << "Reusing the geometry description of '"
+        << files.ROOTfile << "' already loaded";
+    }
+    else {
+      // includes GDML parsing (or snapshot reading) and geometry building
+      // (just the latter if the ROOT geometry is already in memory)
+      auto loadTimer = fProfiler.Step("geometry description");
+      fLoadedDescription.clear();
       fhicl::Table<geo::GeometryBuilderStandard::Config> const config{fBuilderParameters, {"tool_type"}};
-      geo::GeometryBuilderStandard builder{config()};
+      std::unique_ptr<geo::GeometryBuilder> builder;
+      if (fSyntheticWirePlanes.empty())
+        builder = std::make_unique<geo::GeometryBuilderStandard>(config());
+      else {
+        builder = std::make_unique<geo::GeometryBuilderSyntheticWires>
+          (config(), fSyntheticWirePlanes);
+      }
+
+      // initialize the geometry with the files we have found; the ROOT
+      // geometry is imported only if not already loaded by another service
+      // (the source is identified by the original file even if the snapshot
+      // is read)
+      geo::GeometrySourceRegistry::Instance().UseSource(
+        "Geometry", files.ROOTfile,
+        [&](bool import){
+          if (import && !fromSnapshot && fPreloadGDML)
+            PreloadGeometryFile(files.ROOTfile);
+          LoadGeometryFile(files.GDMLfile,
+                           fromSnapshot? files.snapshotFile: files.ROOTfile,
+                           *builder, import);
+        });
+      fLoadedDescription = descriptionKey;
+    }
 
-      // initialize the geometry with the files we have found
-      LoadGeometryFile(GDMLfile, ROOTfile, builder, bForceReload);
+    // save the geometry just parsed for the next time (unless it includes
+    // synthetic wire volumes)
+    if (fGeometryCache && !sameDescription && !fromSnapshot
+      && fSyntheticWirePlanes.empty())
+    {
+      auto cacheTimer = fProfiler.Step("geometry cache update");
+      fGeometryCache->StoreSnapshot(files.ROOTfile, files.descriptionKey);
     }
 
-    // now update the channel map
+    fCurrentGeometry = files;
+
+    // now update the channel map; a geometry is loaded again only for a new
+    // detector name, which is part of the channel mapping input
     InitializeChannelMap();
 
-  } // Geometry::LoadNewGeometry()
+    // reuse the information of this geometry if still available
+    std::string const snapshotKey = SnapshotKey(files);
+    auto snapshot = fSnapshotCache.Find(snapshotKey);
+    if (snapshot) {
+      mf::LogInfo("Geometry")
+        << "Reusing the information precomputed for geometry '"
+        << DetectorName() << "'";
+    }
+    else {
+      snapshot = MakeSnapshot();
+      fSnapshotCache.Insert(snapshotKey, snapshot);
+    }
+
+    // the new information replaces the old one in a single step;
+    // users still holding the old snapshot keep it alive
+    std::atomic_store(&fSnapshot, std::move(snapshot));
+    fGeneration.fetch_add(1U, std::memory_order_acq_rel);
+    lar::invalidateCachedProviders();
+
+  } // Geometry::LoadGeometryFiles()
 
   DEFINE_ART_SERVICE(Geometry)
 } // namespace geo
@@ -0,0 +1,26 @@
+/**
+ * @file   larcore/Geometry/OpticalChannelIndex.cc
+ * @brief  Precomputed map from optical channels to optical detectors.
+ * @see    larcore/Geometry/OpticalChannelIndex.h
+ */
+
+// library header
+#include "larcore/Geometry/OpticalChannelIndex.h"
+
+
+//------------------------------------------------------------------------------
+geo::OpticalChannelIndex::OpticalChannelIndex(geo::GeometryCore const& geom) {
+
+  if (geom.NOpChannels() == 0) return;
+
+  unsigned int const maxOpChannel = geom.MaxOpChannel();
+  fChannelOpDets.resize(maxOpChannel + 1, InvalidOpDet);
+  for (unsigned int opChannel = 0; opChannel <= maxOpChannel; ++opChannel) {
+    if (!geom.IsValidOpChannel(opChannel)) continue;
+    fChannelOpDets[opChannel] = geom.OpDetFromOpChannel(opChannel);
+  } // for
+
+} // geo::OpticalChannelIndex::OpticalChannelIndex()
+
+
+//------------------------------------------------------------------------------
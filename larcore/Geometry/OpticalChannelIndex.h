@@ -0,0 +1,94 @@
+/**
+ * @file   larcore/Geometry/OpticalChannelIndex.h
+ * @brief  Precomputed map from optical channels to optical detectors.
+ * @see    larcore/Geometry/OpticalChannelIndex.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_OPTICALCHANNELINDEX_H
+#define LARCORE_GEOMETRY_OPTICALCHANNELINDEX_H
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/OpDetGeo.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <limits>
+
+
+namespace geo {
+
+  /**
+   * @brief Map from optical channel to optical detector, without exceptions.
+   *
+   * `geo::GeometryCore::OpDetGeoFromOpChannel()` throws an exception for
+   * channels which are not mapped to any optical detector. Code checking many
+   * channels which may be invalid pays the cost of the exception for each of
+   * them. This index is filled once, checking each channel with
+   * `geo::GeometryCore::IsValidOpChannel()`, and its queries never throw:
+   * invalid channels are reported with the `InvalidOpDet` value (or a null
+   * pointer).
+   *
+   * The index stores optical detector numbers, not pointers to the optical
+   * detector objects, so it stays valid for as long as the same geometry is
+   * loaded, even across reloading. For the same reason, the geometry is
+   * needed to obtain the optical detector object.
+   */
+  class OpticalChannelIndex {
+
+      public:
+
+    /// Value returned for channels not associated to any optical detector.
+    static constexpr unsigned int InvalidOpDet
+      = std::numeric_limits<unsigned int>::max();
+
+    /// Constructor: an empty index.
+    OpticalChannelIndex() = default;
+
+    /// Constructor: maps all the optical channels of `geom`.
+    explicit OpticalChannelIndex(geo::GeometryCore const& geom);
+
+    /// Returns the number of channels in the index (`MaxOpChannel() + 1`).
+    unsigned int NOpChannels() const { return fChannelOpDets.size(); }
+
+    /// Returns whether the specified channel is mapped to an optical detector.
+    bool IsValidOpChannel(unsigned int opChannel) const noexcept
+      { return OpDetFromOpChannel(opChannel) != InvalidOpDet; }
+
+    /**
+     * @brief Returns the optical detector serving the specified channel.
+     * @param opChannel the optical channel
+     * @return the optical detector number, or `InvalidOpDet` if none
+     */
+    unsigned int OpDetFromOpChannel(unsigned int opChannel) const noexcept
+      {
+        return (opChannel < fChannelOpDets.size())
+          ? fChannelOpDets[opChannel]: InvalidOpDet;
+      }
+
+    /**
+     * @brief Returns the optical detector serving the specified channel.
+     * @param geom the geometry the index was built from
+     * @param opChannel the optical channel
+     * @return a pointer to the optical detector, `nullptr` if none
+     */
+    geo::OpDetGeo const* OpDetGeoFromOpChannel
+      (geo::GeometryCore const& geom, unsigned int opChannel) const
+      {
+        unsigned int const opDet = OpDetFromOpChannel(opChannel);
+        return (opDet == InvalidOpDet)
+          ? nullptr: &(geom.OpDetGeoFromOpDet(opDet));
+      }
+
+
+      private:
+
+    /// Optical detector of each channel (`InvalidOpDet` if none).
+    std::vector<unsigned int> fChannelOpDets;
+
+  }; // class OpticalChannelIndex
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_OPTICALCHANNELINDEX_H
@@ -0,0 +1,153 @@
+/**
+ * @file   larcore/Geometry/RegularChannelMapAlg.cc
+ * @brief  Standard channel mapping with arithmetic fast path.
+ * @see    larcore/Geometry/RegularChannelMapAlg.h
+ */
+
+// library header
+#include "larcore/Geometry/RegularChannelMapAlg.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/CryostatGeo.h"
+#include "larcorealg/Geometry/TPCGeo.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+
+//------------------------------------------------------------------------------
+void geo::RegularChannelMapAlg::Initialize
+  (geo::GeometryData_t const& geodata)
+{
+  Base_t::Initialize(geodata);
+
+  fRegular = buildRegularMapping(geodata);
+  if (!fRegular) clearRegularMapping();
+
+  if (fRegular) {
+    mf::LogInfo("RegularChannelMapAlg")
+      << "Regular channel mapping: " << fPlaneIDs.size() << " planes, "
+      << NRegularChannels() << " channels; arithmetic mapping enabled.";
+  }
+  else {
+    mf::LogInfo("RegularChannelMapAlg")
+      << "Channel mapping is not regular: using the standard mapping only.";
+  }
+
+} // geo::RegularChannelMapAlg::Initialize()
+
+
+//------------------------------------------------------------------------------
+void geo::RegularChannelMapAlg::Uninitialize() {
+
+  clearRegularMapping();
+  Base_t::Uninitialize();
+
+} // geo::RegularChannelMapAlg::Uninitialize()
+
+
+//------------------------------------------------------------------------------
+void geo::RegularChannelMapAlg::clearRegularMapping() {
+
+  fRegular = false;
+  fNCryostats = 0U;
+  fNTPCs = 0U;
+  fNPlanes = 0U;
+  fUniformWires = 0;
+  fPlaneIDs.clear();
+  fPlaneFirstChannel.clear();
+
+} // geo::RegularChannelMapAlg::clearRegularMapping()
+
+
+//------------------------------------------------------------------------------
+std::vector<geo::WireID> geo::RegularChannelMapAlg::ChannelToWire
+  (raw::ChannelID_t channel) const
+{
+  // invalid channels are left to the standard mapping to complain about
+  if (!fRegular || (channel >= NRegularChannels()))
+    return Base_t::ChannelToWire(channel);
+  return { ChannelToSingleWire(channel) };
+} // geo::RegularChannelMapAlg::ChannelToWire()
+
+
+//------------------------------------------------------------------------------
+raw::ChannelID_t geo::RegularChannelMapAlg::PlaneWireToChannel
+  (geo::WireID const& wireID) const
+{
+  return isRegularWire(wireID)
+    ? WireToChannel(wireID): Base_t::PlaneWireToChannel(wireID);
+} // geo::RegularChannelMapAlg::PlaneWireToChannel()
+
+
+//------------------------------------------------------------------------------
+bool geo::RegularChannelMapAlg::isRegularWire
+  (geo::WireID const& wireID) const
+{
+  if (!fRegular) return false;
+  if (wireID.Cryostat >= fNCryostats) return false;
+  if (wireID.TPC >= fNTPCs) return false;
+  if (wireID.Plane >= fNPlanes) return false;
+  std::size_t const iPlane = planeIndex(wireID);
+  return wireID.Wire
+    < (fPlaneFirstChannel[iPlane + 1] - fPlaneFirstChannel[iPlane]);
+} // geo::RegularChannelMapAlg::isRegularWire()
+
+
+//------------------------------------------------------------------------------
+bool geo::RegularChannelMapAlg::buildRegularMapping
+  (geo::GeometryData_t const& geodata)
+{
+  clearRegularMapping();
+
+  auto const& cryostats = geodata.cryostats;
+  if (cryostats.empty()) return false;
+  fNCryostats = cryostats.size();
+
+  // uniform number of TPC and planes
+  fNTPCs = cryostats.front().NTPC();
+  if (fNTPCs == 0U) return false;
+  fNPlanes = cryostats.front().TPC(0).Nplanes();
+  if (fNPlanes == 0U) return false;
+  for (geo::CryostatGeo const& cryo: cryostats) {
+    if (cryo.NTPC() != fNTPCs) return false;
+    for (unsigned int t = 0; t < fNTPCs; ++t)
+      if (cryo.TPC(t).Nplanes() != fNPlanes) return false;
+  } // for cryostats
+
+  // channels in sequence on the wires, plane after plane
+  raw::ChannelID_t nextChannel = 0;
+  fUniformWires = cryostats.front().TPC(0).Plane(0).Nwires();
+  for (geo::CryostatGeo const& cryo: cryostats) {
+    for (unsigned int t = 0; t < fNTPCs; ++t) {
+      geo::TPCGeo const& tpc = cryo.TPC(t);
+      for (unsigned int p = 0; p < fNPlanes; ++p) {
+        geo::PlaneGeo const& plane = tpc.Plane(p);
+        geo::PlaneID const& planeID = plane.ID();
+        unsigned int const nWires = plane.Nwires();
+        if (nWires != fUniformWires) fUniformWires = 0;
+        fPlaneIDs.push_back(planeID);
+        fPlaneFirstChannel.push_back(nextChannel);
+        for (unsigned int w = 0; w < nWires; ++w) {
+          geo::WireID const wireID { planeID, w };
+          if (Base_t::PlaneWireToChannel(wireID) != nextChannel++) return false;
+        }
+      } // for planes
+    } // for TPC
+  } // for cryostats
+  fPlaneFirstChannel.push_back(nextChannel);
+
+  // each channel covers only the expected wire
+  if (Base_t::Nchannels() != nextChannel) return false;
+  for (raw::ChannelID_t channel = 0; channel < nextChannel; ++channel) {
+    std::vector<geo::WireID> const wires = Base_t::ChannelToWire(channel);
+    if (wires.size() != 1U) return false;
+    if (wires.front() != ChannelToSingleWire(channel)) return false;
+  } // for channels
+
+  return true;
+} // geo::RegularChannelMapAlg::buildRegularMapping()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,174 @@
+/**
+ * @file   larcore/Geometry/RegularChannelMapAlg.h
+ * @brief  Standard channel mapping with arithmetic fast path.
+ * @see    larcore/Geometry/RegularChannelMapAlg.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_REGULARCHANNELMAPALG_H
+#define LARCORE_GEOMETRY_REGULARCHANNELMAPALG_H
+
+// LArSoft libraries
+#include "larcorealg/Geometry/ChannelMapStandardAlg.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+#include "larcoreobj/SimpleTypesAndConstants/RawTypes.h" // raw::ChannelID_t
+
+// framework libraries
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <algorithm> // std::upper_bound()
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  /**
+   * @brief Standard channel mapping, with non-virtual queries for regular
+   *        detectors.
+   *
+   * This channel mapping is the same as `geo::ChannelMapStandardAlg`. After
+   * the initialization, it checks whether the mapping of the detector is
+   * _regular_, that is:
+   *
+   * * all cryostats have the same number of TPC, and all TPC the same number
+   *   of planes;
+   * * each channel covers exactly one wire;
+   * * the channels are assigned in sequence to the wires of each plane,
+   *   plane after plane, in the natural order of the plane IDs.
+   *
+   * In that case (`IsRegular()`), the mapping is a simple arithmetic
+   * relation, and `WireToChannel()` and `ChannelToSingleWire()` compute it
+   * with no virtual call, no memory allocation and (for planes with the same
+   * number of wires) no branch. These functions are inline, and they are
+   * available to the code holding this concrete type, for example via
+   * `geo::Geometry::ChannelMapAs()`:
+   * @code{.cpp}
+   * auto const* channelMap
+   *   = geom->ChannelMapAs<geo::RegularChannelMapAlg>();
+   * if (channelMap && channelMap->IsRegular()) {
+   *   for (auto const& hit: hits)
+   *     process(channelMap->ChannelToSingleWire(hit.Channel()));
+   * }
+   * @endcode
+   * The overrides of the virtual interface `ChannelToWire()` and
+   * `PlaneWireToChannel()` also use the arithmetic mapping when possible.
+   *
+   * If the mapping is not regular, this object behaves exactly like
+   * `geo::ChannelMapStandardAlg`, and the non-virtual queries must not be
+   * used.
+   */
+  class RegularChannelMapAlg final: public geo::ChannelMapStandardAlg {
+
+    using Base_t = geo::ChannelMapStandardAlg;
+
+      public:
+
+    /// Constructor: same configuration as `geo::ChannelMapStandardAlg`.
+    explicit RegularChannelMapAlg(fhicl::ParameterSet const& pset)
+      : Base_t(pset) {}
+
+    void Initialize(geo::GeometryData_t const& geodata) override;
+    void Uninitialize() override;
+
+    using Base_t::PlaneWireToChannel;
+
+    std::vector<geo::WireID> ChannelToWire
+      (raw::ChannelID_t channel) const override;
+
+    raw::ChannelID_t PlaneWireToChannel
+      (geo::WireID const& wireID) const override;
+
+
+    /// @{
+    /// @name Non-virtual queries (only if `IsRegular()`)
+
+    /// Returns whether the mapping is regular (see the class documentation).
+    bool IsRegular() const { return fRegular; }
+
+    /// Returns the number of channels (arithmetic mapping).
+    raw::ChannelID_t NRegularChannels() const
+      { return fPlaneFirstChannel.empty()? 0: fPlaneFirstChannel.back(); }
+
+    /**
+     * @brief Returns the only wire covered by `channel`.
+     * @param channel a valid channel (`channel < NRegularChannels()`)
+     * @return the ID of the wire
+     *
+     * The channel is not checked. The mapping must be `IsRegular()`.
+     */
+    geo::WireID ChannelToSingleWire(raw::ChannelID_t channel) const;
+
+    /**
+     * @brief Returns the channel covering the specified wire.
+     * @param wireID the ID of a valid wire
+     * @return the channel of the wire
+     *
+     * The wire is not checked. The mapping must be `IsRegular()`.
+     */
+    raw::ChannelID_t WireToChannel(geo::WireID const& wireID) const
+      {
+        return fPlaneFirstChannel[planeIndex(wireID)]
+          + static_cast<raw::ChannelID_t>(wireID.Wire);
+      }
+
+    /// @}
+
+
+      private:
+
+    bool fRegular = false; ///< Whether the arithmetic mapping is valid.
+
+    unsigned int fNCryostats = 0U; ///< Number of cryostats.
+    unsigned int fNTPCs = 0U; ///< Number of TPC in each cryostat.
+    unsigned int fNPlanes = 0U; ///< Number of planes in each TPC.
+
+    /// Number of wires in each plane, if the same for all planes (or `0`).
+    raw::ChannelID_t fUniformWires = 0;
+
+    std::vector<geo::PlaneID> fPlaneIDs; ///< ID of each plane, by index.
+
+    /// First channel of each plane, by plane index (plus total).
+    std::vector<raw::ChannelID_t> fPlaneFirstChannel;
+
+    /// Returns the index of the plane of `planeID` (arithmetic).
+    std::size_t planeIndex(geo::PlaneID const& planeID) const
+      {
+        return (std::size_t(planeID.Cryostat) * fNTPCs + planeID.TPC)
+          * fNPlanes + planeID.Plane;
+      }
+
+    /// Returns whether the arithmetic mapping can be used for `wireID`.
+    bool isRegularWire(geo::WireID const& wireID) const;
+
+    /// Removes the arithmetic mapping.
+    void clearRegularMapping();
+
+    /// Fills the arithmetic mapping; returns whether it matches the standard.
+    bool buildRegularMapping(geo::GeometryData_t const& geodata);
+
+  }; // class RegularChannelMapAlg
+
+} // namespace geo
+
+
+//------------------------------------------------------------------------------
+//--- inline implementation
+//---
+inline geo::WireID geo::RegularChannelMapAlg::ChannelToSingleWire
+  (raw::ChannelID_t channel) const
+{
+  std::size_t iPlane;
+  if (fUniformWires > 0) iPlane = channel / fUniformWires;
+  else {
+    iPlane = std::upper_bound
+      (fPlaneFirstChannel.begin(), fPlaneFirstChannel.end(), channel)
+      - fPlaneFirstChannel.begin() - 1;
+  }
+  return { fPlaneIDs[iPlane], channel - fPlaneFirstChannel[iPlane] };
+} // geo::RegularChannelMapAlg::ChannelToSingleWire()
+
+
+//------------------------------------------------------------------------------
+
+#endif // LARCORE_GEOMETRY_REGULARCHANNELMAPALG_H
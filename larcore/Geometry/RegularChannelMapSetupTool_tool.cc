@@ -0,0 +1,60 @@
+/**
+ * @file   larcore/Geometry/RegularChannelMapSetupTool_tool.cc
+ * @brief  Tool creating a `geo::RegularChannelMapAlg` channel mapping.
+ * @see    larcore/Geometry/ChannelMapSetupTool.h
+ */
+
+// LArSoft libraries
+#include "larcore/Geometry/ChannelMapSetupTool.h"
+#include "larcore/Geometry/RegularChannelMapAlg.h"
+
+// framework libraries
+#include "art/Utilities/ToolMacros.h"
+#include "fhiclcpp/ParameterSet.h"
+
+// C/C++ standard libraries
+#include <memory> // std::make_unique()
+
+
+namespace geo { class RegularChannelMapSetupTool; }
+
+/**
+ * @brief Tool creating a `geo::RegularChannelMapAlg` channel mapping.
+ *
+ * The channel mapping is the standard one (`geo::ChannelMapStandardAlg`),
+ * with non-virtual queries for detectors with a regular layout (see
+ * `geo::RegularChannelMapAlg`).
+ *
+ * Configuration parameters
+ * -------------------------
+ *
+ * - *SortingParameters* (parameter set, default: empty): configuration of
+ *   the channel mapping algorithm, as for `geo::ChannelMapStandardAlg`
+ */
+class geo::RegularChannelMapSetupTool: public geo::ChannelMapSetupTool {
+
+    public:
+
+  explicit RegularChannelMapSetupTool(fhicl::ParameterSet const& pset)
+    : fSortingParameters
+      (pset.get<fhicl::ParameterSet>("SortingParameters", {}))
+    {}
+
+    protected:
+
+  /// Returns a new `geo::RegularChannelMapAlg` instance.
+  virtual std::unique_ptr<geo::ChannelMapAlg> doChannelMap() override
+    { return std::make_unique<geo::RegularChannelMapAlg>(fSortingParameters); }
+
+    private:
+
+  fhicl::ParameterSet fSortingParameters; ///< Channel mapping configuration.
+
+}; // class geo::RegularChannelMapSetupTool
+
+
+//------------------------------------------------------------------------------
+DEFINE_ART_CLASS_TOOL(geo::RegularChannelMapSetupTool)
+
+
+//------------------------------------------------------------------------------
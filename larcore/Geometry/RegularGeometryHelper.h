@@ -0,0 +1,45 @@
+/**
+ * @file   RegularGeometryHelper.h
+ * @brief  Geometry helper service serving a standard mapping with fast path
+ * @see    RegularGeometryHelper_service.cc
+ *
+ * Handles detector-specific information for the generic Geometry service
+ * within LArSoft. Derived from the ExptGeoHelperInterface class. This version
+ * provides the standard channel mapping, with non-virtual queries for
+ * detectors with regular layout.
+ */
+
+#ifndef GEO_RegularGeometryHelper_h
+#define GEO_RegularGeometryHelper_h
+
+// LArSoft libraries
+#include "larcore/Geometry/ExptGeoHelperInterface.h"
+
+namespace geo
+{
+  /**
+   * @brief Standard channel mapping with arithmetic fast path
+   *
+   * This ExptGeoHelperInterface implementation serves a RegularChannelMapAlg,
+   * which is equivalent to ChannelMapStandardAlg and, if the detector layout
+   * is regular, also offers non-virtual channel mapping queries (see
+   * geo::RegularChannelMapAlg and geo::Geometry::ChannelMapAs()).
+   * It can replace StandardGeometryHelper in any configuration.
+   */
+  class RegularGeometryHelper : public ExptGeoHelperInterface {
+  public:
+    explicit RegularGeometryHelper(fhicl::ParameterSet const& pset);
+
+  private:
+    ChannelMapAlgPtr_t
+    doConfigureChannelMapAlg(fhicl::ParameterSet const& sortingParameters,
+                             std::string const& detectorName) const override;
+  };
+
+}
+
+DECLARE_ART_SERVICE_INTERFACE_IMPL(geo::RegularGeometryHelper,
+                                   geo::ExptGeoHelperInterface,
+                                   SHARED)
+
+#endif // GEO_RegularGeometryHelper_h
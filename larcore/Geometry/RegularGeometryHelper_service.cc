@@ -0,0 +1,37 @@
+////////////////////////////////////////////////////////////////////////////////
+/// \file RegularGeometryHelper_service.cc
+///
+/// \brief Geometry helper serving geo::RegularChannelMapAlg
+////////////////////////////////////////////////////////////////////////////////
+
+// class header
+#include "larcore/Geometry/RegularGeometryHelper.h"
+
+// LArSoft libraries
+#include "larcore/Geometry/RegularChannelMapAlg.h"
+
+// framework libraries
+#include "messagefacility/MessageLogger/MessageLogger.h"
+
+namespace geo
+{
+
+  //----------------------------------------------------------------------------
+  RegularGeometryHelper::RegularGeometryHelper(fhicl::ParameterSet const& pset)
+    : ExptGeoHelperInterface(pset)
+  {}
+
+  //----------------------------------------------------------------------------
+  RegularGeometryHelper::ChannelMapAlgPtr_t
+  RegularGeometryHelper::doConfigureChannelMapAlg(fhicl::ParameterSet const& sortingParameters,
+                                                  std::string const& /*detectorName*/) const
+  {
+    mf::LogInfo("RegularGeometryHelper")
+      << "Loading channel mapping: RegularChannelMapAlg";
+    return std::make_unique<geo::RegularChannelMapAlg>(sortingParameters);
+  }
+
+} // namespace geo
+
+DEFINE_ART_SERVICE_INTERFACE_IMPL(geo::RegularGeometryHelper,
+                                  geo::ExptGeoHelperInterface)
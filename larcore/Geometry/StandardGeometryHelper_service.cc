@@ -18,7 +18,8 @@ namespace geo
 {
 
   //----------------------------------------------------------------------------
-  StandardGeometryHelper::StandardGeometryHelper(fhicl::ParameterSet const&)
+  StandardGeometryHelper::StandardGeometryHelper(fhicl::ParameterSet const& pset)
+    : ExptGeoHelperInterface(pset)
   {}
 
   //----------------------------------------------------------------------------
@@ -0,0 +1,129 @@
+/**
+ * @file   larcore/Geometry/UniformGridIndex.cc
+ * @brief  Uniform grid of axis-aligned boxes for fast point location.
+ * @see    larcore/Geometry/UniformGridIndex.h
+ */
+
+// library header
+#include "larcore/Geometry/UniformGridIndex.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min(), std::max()
+#include <cmath> // std::pow(), std::ceil(), std::floor()
+
+
+namespace {
+
+  /// Maximum number of cells on each axis.
+  constexpr double MaxCellsPerAxis = 1024.0;
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+geo::UniformGridIndex::UniformGridIndex
+  (std::vector<Box_t> const& boxes, double cellsPerBox /* = 8.0 */)
+  : fNBoxes(boxes.size())
+{
+  if (boxes.empty()) return;
+
+  // bounding box of all the boxes
+  fMin = boxes.front().min;
+  fMax = boxes.front().max;
+  for (Box_t const& box: boxes) {
+    for (unsigned int axis = 0; axis < 3U; ++axis) {
+      fMin[axis] = std::min(fMin[axis], box.min[axis]);
+      fMax[axis] = std::max(fMax[axis], box.max[axis]);
+    }
+  } // for boxes
+
+  // cells as close as possible to cubes, about `cellsPerBox` per box;
+  // flat dimensions (if any) get a single cell
+  double measure = 1.0;
+  unsigned int nDims = 0U;
+  for (unsigned int axis = 0; axis < 3U; ++axis) {
+    double const extent = fMax[axis] - fMin[axis];
+    if (extent <= 0.0) continue;
+    measure *= extent;
+    ++nDims;
+  } // for axes
+  double const nTargetCells = std::max(1.0, cellsPerBox * boxes.size());
+  double const side = (nDims == 0U)
+    ? 1.0: std::pow(measure / nTargetCells, 1.0 / nDims);
+  for (unsigned int axis = 0; axis < 3U; ++axis) {
+    double const extent = fMax[axis] - fMin[axis];
+    fNCells[axis] = (extent > 0.0)
+      ? static_cast<std::size_t>
+        (std::max(1.0, std::min(MaxCellsPerAxis, std::ceil(extent / side))))
+      : 1U;
+    fCellSize[axis] = (extent > 0.0)? (extent / fNCells[axis]): 1.0;
+  } // for axes
+
+  // first pass: count the boxes per cell; second pass: fill them
+  std::size_t const nCells = fNCells[0] * fNCells[1] * fNCells[2];
+  fCellOffsets.assign(nCells + 1, 0U);
+
+  auto forEachCell = [this](Box_t const& box, auto&& action)
+    {
+      std::array<std::size_t, 3U> first, last;
+      for (unsigned int axis = 0; axis < 3U; ++axis) {
+        first[axis] = std::max(0L, cellOnAxis(axis, box.min[axis]));
+        long const lastCell = cellOnAxis(axis, box.max[axis]);
+        last[axis] = (lastCell < 0)? (fNCells[axis] - 1): lastCell;
+      }
+      for (std::size_t i = first[0]; i <= last[0]; ++i)
+        for (std::size_t j = first[1]; j <= last[1]; ++j)
+          for (std::size_t k = first[2]; k <= last[2]; ++k)
+            action(cellIndex(i, j, k));
+    };
+
+  for (Box_t const& box: boxes)
+    forEachCell(box, [this](std::size_t cell){ ++fCellOffsets[cell + 1]; });
+  for (std::size_t cell = 0; cell < nCells; ++cell)
+    fCellOffsets[cell + 1] += fCellOffsets[cell];
+
+  fCellBoxes.resize(fCellOffsets.back());
+  std::vector<std::size_t> filled(fCellOffsets.begin(), fCellOffsets.end() - 1);
+  for (std::size_t iBox = 0; iBox < boxes.size(); ++iBox) {
+    // boxes are added in order, so each cell list is sorted
+    forEachCell(boxes[iBox], [this, iBox, &filled](std::size_t cell)
+      { fCellBoxes[filled[cell]++] = iBox; });
+  } // for boxes
+
+} // geo::UniformGridIndex::UniformGridIndex()
+
+
+//------------------------------------------------------------------------------
+auto geo::UniformGridIndex::Candidates(double x, double y, double z) const
+  -> Range_t
+{
+  if (fCellOffsets.empty()) return {};
+
+  long const i = cellOnAxis(0, x);
+  if (i < 0) return {};
+  long const j = cellOnAxis(1, y);
+  if (j < 0) return {};
+  long const k = cellOnAxis(2, z);
+  if (k < 0) return {};
+
+  std::size_t const cell = cellIndex(i, j, k);
+  return {
+    fCellBoxes.data() + fCellOffsets[cell],
+    fCellBoxes.data() + fCellOffsets[cell + 1]
+    };
+} // geo::UniformGridIndex::Candidates()
+
+
+//------------------------------------------------------------------------------
+long geo::UniformGridIndex::cellOnAxis(unsigned int axis, double c) const {
+  double const pos = (c - fMin[axis]) / fCellSize[axis];
+  if (!(pos >= 0.0)) return -1; // also catches NaN
+  long const nCells = fNCells[axis];
+  long const cell = static_cast<long>(std::floor(pos));
+  // the upper border (and rounding around it) belongs to the last cell
+  if (cell >= nCells) return (c <= fMax[axis])? (nCells - 1): -1;
+  return cell;
+} // geo::UniformGridIndex::cellOnAxis()
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,102 @@
+/**
+ * @file   larcore/Geometry/UniformGridIndex.h
+ * @brief  Uniform grid of axis-aligned boxes for fast point location.
+ * @see    larcore/Geometry/UniformGridIndex.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_UNIFORMGRIDINDEX_H
+#define LARCORE_GEOMETRY_UNIFORMGRIDINDEX_H
+
+// C/C++ standard libraries
+#include <array>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  /**
+   * @brief Spatial index of a set of boxes, on a uniform grid.
+   *
+   * The volume including all the boxes is split in a grid of cells of equal
+   * size, and each cell records which of the boxes overlap with it.
+   * For a given point, `Candidates()` returns all the boxes which may contain
+   * it, in increasing order of their index: all the others certainly don't.
+   * The exact containment test is left to the caller.
+   *
+   * The number of cells is chosen proportional to the number of boxes; the
+   * cost of a query does not depend on the number of boxes, as long as they
+   * are not all concentrated in a small part of the volume.
+   */
+  class UniformGridIndex {
+
+      public:
+
+    /// An axis-aligned box.
+    struct Box_t {
+      std::array<double, 3U> min; ///< Lower corner.
+      std::array<double, 3U> max; ///< Upper corner.
+    }; // Box_t
+
+    /// A range of box indices.
+    class Range_t {
+      std::size_t const* fBegin = nullptr;
+      std::size_t const* fEnd = nullptr;
+        public:
+      Range_t() = default;
+      Range_t(std::size_t const* b, std::size_t const* e)
+        : fBegin(b), fEnd(e) {}
+      std::size_t const* begin() const { return fBegin; }
+      std::size_t const* end() const { return fEnd; }
+      std::size_t size() const { return fEnd - fBegin; }
+      bool empty() const { return fBegin == fEnd; }
+    }; // Range_t
+
+
+    /// Constructor: an empty index.
+    UniformGridIndex() = default;
+
+    /**
+     * @brief Constructor: indexes the specified boxes.
+     * @param boxes the boxes to be indexed
+     * @param cellsPerBox average number of grid cells per box
+     *
+     * Boxes are identified by their position in `boxes`.
+     */
+    explicit UniformGridIndex
+      (std::vector<Box_t> const& boxes, double cellsPerBox = 8.0);
+
+    /// Returns the number of boxes in the index.
+    std::size_t size() const { return fNBoxes; }
+
+    /// Returns the boxes which may contain the point `( x, y, z )`.
+    Range_t Candidates(double x, double y, double z) const;
+
+
+      private:
+
+    std::size_t fNBoxes = 0U; ///< Number of boxes.
+
+    std::array<double, 3U> fMin {{ 0.0, 0.0, 0.0 }}; ///< Grid lower corner.
+    std::array<double, 3U> fMax {{ 0.0, 0.0, 0.0 }}; ///< Grid upper corner.
+    std::array<double, 3U> fCellSize {{ 1.0, 1.0, 1.0 }}; ///< Size of cells.
+    std::array<std::size_t, 3U> fNCells {{ 0U, 0U, 0U }}; ///< Cells per axis.
+
+    /// Position of the first box of each cell in `fCellBoxes` (plus total).
+    std::vector<std::size_t> fCellOffsets;
+
+    std::vector<std::size_t> fCellBoxes; ///< Boxes of all cells, in sequence.
+
+    /// Returns the index of the cell on `axis` for coordinate `c` (or -1).
+    long cellOnAxis(unsigned int axis, double c) const;
+
+    /// Returns the linear index of the cell with the specified indices.
+    std::size_t cellIndex(std::size_t i, std::size_t j, std::size_t k) const
+      { return (i * fNCells[1] + j) * fNCells[2] + k; }
+
+  }; // class UniformGridIndex
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_UNIFORMGRIDINDEX_H
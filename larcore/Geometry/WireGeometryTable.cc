@@ -0,0 +1,144 @@
+/**
+ * @file   larcore/Geometry/WireGeometryTable.cc
+ * @brief  Precomputed wire geometry in flat arrays, and batch wire crossings.
+ * @see    larcore/Geometry/WireGeometryTable.h
+ */
+
+// library header
+#include "larcore/Geometry/WireGeometryTable.h"
+
+// LArSoft libraries
+#include "larcorealg/Geometry/GeometryCore.h"
+#include "larcorealg/Geometry/PlaneGeo.h"
+#include "larcorealg/Geometry/WireGeo.h"
+
+// C/C++ standard libraries
+#include <algorithm> // std::min()
+#include <array>
+#include <cmath> // std::abs()
+#include <limits> // std::numeric_limits<>
+
+
+namespace {
+
+  /// Number of wire pairs converted to indices in a single block.
+  constexpr std::size_t CrossingBlockSize = 256U;
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+geo::WireGeometryTable::WireGeometryTable(geo::GeometryCore const& geom)
+  : fIndexer(geom)
+{
+  std::size_t const nWires = fIndexer.NWires();
+  for (std::vector<double>* array: {
+    &fWires.centerX, &fWires.centerY, &fWires.centerZ,
+    &fWires.dirX, &fWires.dirY, &fWires.dirZ, &fWires.halfLength
+    }
+  )
+    array->reserve(nWires);
+  fPlanePitches.reserve(fIndexer.NPlanes());
+
+  // planes and their wires are visited in the order of the indexer
+  for (geo::PlaneGeo const& plane: geom.IteratePlanes()) {
+    fPlanePitches.push_back(plane.WirePitch());
+    for (unsigned int w = 0; w < plane.Nwires(); ++w) {
+      geo::WireGeo const& wire = plane.Wire(w);
+      auto const center = wire.GetCenter<geo::Point_t>();
+      auto const dir = wire.Direction<geo::Vector_t>();
+      fWires.centerX.push_back(center.X());
+      fWires.centerY.push_back(center.Y());
+      fWires.centerZ.push_back(center.Z());
+      fWires.dirX.push_back(dir.X());
+      fWires.dirY.push_back(dir.Y());
+      fWires.dirZ.push_back(dir.Z());
+      fWires.halfLength.push_back(wire.HalfL());
+    } // for wires
+  } // for planes
+
+} // geo::WireGeometryTable::WireGeometryTable()
+
+
+//------------------------------------------------------------------------------
+void geo::WireGeometryTable::WireCrossings(
+  geo::WireID const* first, geo::WireID const* second, std::size_t n,
+  double* y, double* z, bool* cross
+) const {
+
+  constexpr std::size_t InvalidIndex = geo::GeometryIDIndexer::InvalidIndex;
+  constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+  // IDs are converted into indices a block at a time, in local buffers;
+  // wires not in the table are temporarily replaced by the first one
+  std::array<std::size_t, CrossingBlockSize> firstIndices, secondIndices;
+  std::array<bool, CrossingBlockSize> invalid;
+
+  for (std::size_t begin = 0; begin < n; begin += CrossingBlockSize) {
+    std::size_t const nPairs = std::min(CrossingBlockSize, n - begin);
+
+    bool anyValid = false;
+    for (std::size_t i = 0; i < nPairs; ++i) {
+      firstIndices[i] = fIndexer.WireIndex(first[begin + i]);
+      secondIndices[i] = fIndexer.WireIndex(second[begin + i]);
+      invalid[i] = (firstIndices[i] == InvalidIndex)
+        || (secondIndices[i] == InvalidIndex);
+      if (invalid[i]) firstIndices[i] = secondIndices[i] = 0U;
+      else anyValid = true;
+    } // for
+
+    if (anyValid) {
+      WireCrossings(firstIndices.data(), secondIndices.data(), nPairs,
+        y + begin, z + begin, cross + begin);
+    }
+
+    for (std::size_t i = 0; i < nPairs; ++i) {
+      if (invalid[i]) {
+        y[begin + i] = z[begin + i] = NaN;
+        cross[begin + i] = false;
+        continue;
+      }
+      geo::WireID const& a = first[begin + i];
+      geo::WireID const& b = second[begin + i];
+      if ((a.Cryostat != b.Cryostat) || (a.TPC != b.TPC))
+        cross[begin + i] = false;
+    } // for pairs
+  } // for blocks
+
+} // geo::WireGeometryTable::WireCrossings(WireID)
+
+
+//------------------------------------------------------------------------------
+void geo::WireGeometryTable::WireCrossings(
+  std::size_t const* first, std::size_t const* second, std::size_t n,
+  double* y, double* z, bool* cross
+) const {
+
+  double const* centerY = fWires.centerY.data();
+  double const* centerZ = fWires.centerZ.data();
+  double const* dirY = fWires.dirY.data();
+  double const* dirZ = fWires.dirZ.data();
+  double const* halfLength = fWires.halfLength.data();
+
+  // solves centerA + s dirA = centerB + t dirB on the y-z plane;
+  // parallel wires yield non-finite s and t, and they never cross
+  for (std::size_t i = 0; i < n; ++i) {
+    std::size_t const a = first[i];
+    std::size_t const b = second[i];
+
+    double const deltaY = centerY[b] - centerY[a];
+    double const deltaZ = centerZ[b] - centerZ[a];
+    double const det = dirY[a] * dirZ[b] - dirZ[a] * dirY[b];
+    double const s = (deltaY * dirZ[b] - deltaZ * dirY[b]) / det;
+    double const t = (deltaY * dirZ[a] - deltaZ * dirY[a]) / det;
+
+    y[i] = centerY[a] + s * dirY[a];
+    z[i] = centerZ[a] + s * dirZ[a];
+    cross[i]
+      = (std::abs(s) <= halfLength[a]) & (std::abs(t) <= halfLength[b]);
+  } // for pairs
+
+} // geo::WireGeometryTable::WireCrossings(indices)
+
+
+//------------------------------------------------------------------------------
@@ -0,0 +1,146 @@
+/**
+ * @file   larcore/Geometry/WireGeometryTable.h
+ * @brief  Precomputed wire geometry in flat arrays, and batch wire crossings.
+ * @see    larcore/Geometry/WireGeometryTable.cc
+ */
+
+#ifndef LARCORE_GEOMETRY_WIREGEOMETRYTABLE_H
+#define LARCORE_GEOMETRY_WIREGEOMETRYTABLE_H
+
+// LArSoft libraries
+#include "larcore/Geometry/GeometryIDIndexer.h"
+#include "larcoreobj/SimpleTypesAndConstants/geo_types.h"
+
+// C/C++ standard libraries
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  class GeometryCore;
+
+  /**
+   * @brief Geometry of all the wires, in structure-of-arrays form.
+   *
+   * The center, direction and half length of all the wires, and the pitch of
+   * all the planes, are copied at construction into contiguous arrays, one per
+   * coordinate, in the dense order defined by `geo::GeometryIDIndexer`.
+   *
+   * The main purpose is the computation of the crossing points of many pairs
+   * of wires at once (`WireCrossings()`), as needed for example when matching
+   * hits from different planes. The crossing of wires `a` and `b` is computed
+   * on the _y_-_z_ plane, solving
+   * @f$ \vec{c}_{a} + s \hat{d}_{a} = \vec{c}_{b} + t \hat{d}_{b} @f$
+   * where @f$ \vec{c} @f$ are the wire centers and @f$ \hat{d} @f$ the wire
+   * directions; the wires actually cross if @f$ |s| @f$ and @f$ |t| @f$ are
+   * not larger than the respective half lengths. The inner loop is free of
+   * branches and works on contiguous arrays, so that the compiler can
+   * vectorize it.
+   *
+   * Parallel wires do not cross, and their crossing coordinates are not
+   * finite numbers.
+   *
+   * The table is immutable, and it must be built again for each new geometry.
+   */
+  class WireGeometryTable {
+
+      public:
+
+    /// Wire information, one array per quantity, indexed by wire index.
+    struct WireArrays_t {
+      std::vector<double> centerX; ///< _x_ coordinate of wire center [cm]
+      std::vector<double> centerY; ///< _y_ coordinate of wire center [cm]
+      std::vector<double> centerZ; ///< _z_ coordinate of wire center [cm]
+      std::vector<double> dirX; ///< _x_ component of wire direction
+      std::vector<double> dirY; ///< _y_ component of wire direction
+      std::vector<double> dirZ; ///< _z_ component of wire direction
+      std::vector<double> halfLength; ///< half length of the wire [cm]
+    }; // WireArrays_t
+
+
+    /// Constructor: an empty table.
+    WireGeometryTable() = default;
+
+    /// Constructor: copies the geometry of all the wires of `geom`.
+    explicit WireGeometryTable(geo::GeometryCore const& geom);
+
+    /// Returns the indexer defining the order of wires and planes.
+    geo::GeometryIDIndexer const& Indexer() const { return fIndexer; }
+
+    /// Returns the number of wires in the table.
+    std::size_t NWires() const { return fWires.halfLength.size(); }
+
+    /// Returns the arrays with the geometry of all the wires.
+    WireArrays_t const& Wires() const { return fWires; }
+
+    /// Returns the wire pitch of the plane with the specified index [cm].
+    double Pitch(std::size_t planeIndex) const
+      { return fPlanePitches[planeIndex]; }
+
+    /// Returns the wire pitch of the specified plane [cm].
+    double Pitch(geo::PlaneID const& planeid) const
+      { return Pitch(fIndexer.PlaneIndex(planeid)); }
+
+
+    /// @{
+    /// @name Batch wire crossings
+
+    /**
+     * @brief Computes the crossing points of the specified pairs of wires.
+     * @param first pointer to the first wire of each pair
+     * @param second pointer to the second wire of each pair
+     * @param n number of pairs
+     * @param[out] y where to write the _y_ coordinate of crossings [cm]
+     * @param[out] z where to write the _z_ coordinate of crossings [cm]
+     * @param[out] cross where to write whether the wires of each pair cross
+     *
+     * The pair `i` is made of `first[i]` and `second[i]`; each output array
+     * must have room for `n` values. The crossing point is the one of the
+     * two infinite lines the wires lie on, and it is written even when the
+     * wires do not cross within their length (`cross[i]` false).
+     * Pairs of wires in different TPC never cross. Pairs including a wire
+     * not in the table do not cross either, and their crossing point
+     * coordinates are NaN.
+     */
+    void WireCrossings(
+      geo::WireID const* first, geo::WireID const* second, std::size_t n,
+      double* y, double* z, bool* cross
+      ) const;
+
+    /**
+     * @brief Computes the crossing points of the specified pairs of wires.
+     * @param first pointer to the index of the first wire of each pair
+     * @param second pointer to the index of the second wire of each pair
+     * @param n number of pairs
+     * @param[out] y where to write the _y_ coordinate of crossings [cm]
+     * @param[out] z where to write the _z_ coordinate of crossings [cm]
+     * @param[out] cross where to write whether the wires of each pair cross
+     * @see `WireCrossings(geo::WireID const*, geo::WireID const*, ...)`
+     *
+     * This version takes wire indices (`Indexer().WireIndex()`), and it
+     * does not check that the wires belong to the same TPC, nor that the
+     * indices are valid.
+     */
+    void WireCrossings(
+      std::size_t const* first, std::size_t const* second, std::size_t n,
+      double* y, double* z, bool* cross
+      ) const;
+
+    /// @}
+
+
+      private:
+
+    geo::GeometryIDIndexer fIndexer; ///< Dense order of wires and planes.
+
+    WireArrays_t fWires; ///< Geometry of all the wires.
+
+    std::vector<double> fPlanePitches; ///< Wire pitch of each plane.
+
+  }; // class WireGeometryTable
+
+} // namespace geo
+
+
+#endif // LARCORE_GEOMETRY_WIREGEOMETRYTABLE_H
@@ -0,0 +1,116 @@
+/**
+ * @file   larcore/Geometry/gdml/make_gdml.cc
+ * @brief  Builds GDML detector descriptions from GDML fragments.
+ * @see    larcore/Geometry/GDMLAssembler.h
+ *
+ * This is a drop-in replacement of `make_gdml.pl`, with the same options and
+ * output:
+ *
+ *     make_gdml -i bo-gdml-fragments.xml -o bo.gdml
+ *     generate_gdml.pl -i parameters.xml | make_gdml -o detector.gdml
+ *
+ * In addition, more than one `-i ... -o ...` pair can be specified: all the
+ * descriptions are built in the same run, and fragments shared by them (like
+ * materials, in the variants with and without wires) are read only once.
+ */
+
+// LArSoft libraries
+#include "larcore/Geometry/GDMLAssembler.h"
+
+// framework libraries
+#include "cetlib_except/exception.h"
+
+// C/C++ standard libraries
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility> // std::pair<>
+#include <vector>
+
+
+namespace {
+
+  void usage(char const* program) {
+    std::cout << "Usage: " << program
+      << " [-h|--help] [-i|--input <xml-fragments-file>]"
+         " [-o|--output <output-file>] [-i ... -o ...]"
+      << "\n       -i/--input can be omitted; if no input file, defaults to STDIN"
+      << "\n       if -o is omitted, output goes to STDOUT"
+      << "\n       each -o writes the description from the preceding -i"
+      << "\n       -h prints this message, then quits"
+      << std::endl;
+  } // usage()
+
+
+  bool isReadable(std::string const& path)
+    { return std::ifstream(path).good(); }
+
+} // local namespace
+
+
+//------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+
+  // (input, output) pairs; "-" stands for standard input and output
+  std::vector<std::pair<std::string, std::string>> jobs;
+  bool outputPending = false;
+
+  for (int iArg = 1; iArg < argc; ++iArg) {
+    std::string const arg = argv[iArg];
+    if ((arg == "-h") || (arg == "--help")) {
+      usage(argv[0]);
+      return 0;
+    }
+    else if ((arg == "-i") || (arg == "--input")) {
+      if (++iArg == argc) { usage(argv[0]); return 1; }
+      jobs.emplace_back(argv[iArg], "-");
+      outputPending = true;
+    }
+    else if ((arg == "-o") || (arg == "--output")) {
+      if (++iArg == argc) { usage(argv[0]); return 1; }
+      if (!outputPending) jobs.emplace_back("-", "-");
+      jobs.back().second = argv[iArg];
+      outputPending = false;
+    }
+    else if (jobs.empty()) { // the first non-option argument is the input
+      jobs.emplace_back(arg, "-");
+      outputPending = true;
+    }
+  } // for arguments
+  if (jobs.empty()) jobs.emplace_back("-", "-");
+
+  for (auto const& [ input, output ]: jobs) {
+    if ((input != "-") && !isReadable(input)) {
+      std::cout << "Input file " << input
+        << " not found or cannot be read" << std::endl;
+      usage(argv[0]);
+      return 1;
+    }
+  } // for
+
+  geo::GDMLAssembler assembler;
+  try {
+    for (auto const& [ input, output ]: jobs) {
+      assembler.Reset();
+      if (input == "-") assembler.AddConfiguration(std::cin);
+      else              assembler.AddConfiguration(input);
+
+      if (output == "-") {
+        assembler.Write(std::cout);
+        continue;
+      }
+      std::ofstream out(output);
+      if (!out) {
+        std::cerr << "Could not open " << output << " for writing" << std::endl;
+        return 1;
+      }
+      assembler.Write(out);
+    } // for jobs
+  }
+  catch (cet::exception const& e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  return 0;
+} // main()
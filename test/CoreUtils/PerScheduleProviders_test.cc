@@ -0,0 +1,147 @@
+/**
+ * @file   PerScheduleProviders_test.cc
+ * @brief  Tests the provider replicas in PerScheduleProviders.h
+ * @see    PerScheduleProviders.h
+ *
+ * This test takes no command line argument.
+ *
+ */
+
+#define BOOST_TEST_MODULE ( PerScheduleProviders_test )
+
+// LArSoft libraries
+#include "larcorealg/CoreUtils/UncopiableAndUnmovableClass.h"
+#include "larcore/CoreUtils/PerScheduleProviders.h"
+
+// art libraries
+#include "canvas/Utilities/Exception.h"
+
+// Boost libraries
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// C/C++ standard libraries
+#include <functional> // std::function<>
+#include <memory> // std::make_unique()
+#include <thread>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+struct MyProvider: protected lar::UncopiableAndUnmovableClass {
+
+   std::size_t schedule;
+   unsigned int run = 0U;
+
+   MyProvider(std::size_t schedule): schedule(schedule) {}
+
+}; // MyProvider
+
+using MyService = lar::PerScheduleProviders<MyProvider>;
+
+static_assert(lar::details::hasPerScheduleProvider<MyService>());
+
+
+/// Imitation of the art registry, recording the module callbacks.
+struct FakeRegistry {
+
+   struct ModuleContext {
+      struct ScheduleID {
+         std::size_t index;
+         std::size_t id() const { return index; }
+      };
+      std::size_t schedule;
+      ScheduleID scheduleID() const { return { schedule }; }
+   }; // ModuleContext
+
+   struct Signal {
+      std::vector<std::function<void(ModuleContext const&)>> callbacks;
+      void watch(std::function<void(ModuleContext const&)> callback)
+        { callbacks.push_back(std::move(callback)); }
+      void invoke(std::size_t schedule) const
+        { for (auto const& callback: callbacks) callback({ schedule }); }
+   }; // Signal
+
+   Signal sPreModule, sPostModule;
+
+}; // FakeRegistry
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(ReplicaTest) {
+
+   MyService service
+     { 3U, [](std::size_t i){ return std::make_unique<MyProvider>(i); } };
+   BOOST_TEST(service.nSchedules() == 3U);
+
+   // each thread sees the replica of its schedule
+   std::vector<MyProvider const*> seen(service.nSchedules(), nullptr);
+   std::vector<std::thread> threads;
+   for (std::size_t iSched = 0; iSched < service.nSchedules(); ++iSched) {
+     threads.emplace_back([&service, &seen, iSched](){
+       MyService::SetCurrentSchedule(iSched);
+       seen[iSched] = service.provider();
+     });
+   } // for
+   for (auto& thread: threads) thread.join();
+
+   for (std::size_t iSched = 0; iSched < service.nSchedules(); ++iSched) {
+     BOOST_TEST(seen[iSched] == service.replica(iSched));
+     BOOST_TEST(seen[iSched]->schedule == iSched);
+   }
+
+   // out of a schedule, the replica of no schedule is used
+   BOOST_TEST(MyService::CurrentSchedule() == MyService::NoSchedule());
+   BOOST_TEST(service.provider()->schedule == MyService::NoSchedule());
+   for (std::size_t iSched = 0; iSched < service.nSchedules(); ++iSched)
+     BOOST_TEST(service.provider() != service.replica(iSched));
+
+   unsigned int nReplicas = 0U;
+   service.forEachReplica
+     ([&nReplicas](std::size_t, MyProvider& prov)
+       { prov.run = 2U; ++nReplicas; }
+     );
+   BOOST_TEST(nReplicas == 4U);
+   for (std::size_t iSched = 0; iSched < service.nSchedules(); ++iSched)
+     BOOST_TEST(service.replica(iSched)->run == 2U);
+   BOOST_TEST(service.provider()->run == 2U);
+
+} // BOOST_AUTO_TEST_CASE(ReplicaTest)
+
+
+BOOST_AUTO_TEST_CASE(ModuleSignalTest) {
+
+   FakeRegistry reg;
+   MyService service
+     { reg, 3U, [](std::size_t i){ return std::make_unique<MyProvider>(i); } };
+   BOOST_TEST(service.provider()->schedule == MyService::NoSchedule());
+
+   // a module on schedule #1...
+   reg.sPreModule.invoke(1U);
+   BOOST_TEST(service.provider() == service.replica(1U));
+
+   // ... waits for its tasks, and the thread runs a module of schedule #2...
+   reg.sPreModule.invoke(2U);
+   BOOST_TEST(service.provider() == service.replica(2U));
+   reg.sPostModule.invoke(2U);
+
+   // ... then the first module resumes, still on its own schedule
+   BOOST_TEST(service.provider() == service.replica(1U));
+   reg.sPostModule.invoke(1U);
+
+   BOOST_TEST(MyService::CurrentSchedule() == MyService::NoSchedule());
+   BOOST_TEST(service.provider()->schedule == MyService::NoSchedule());
+
+} // BOOST_AUTO_TEST_CASE(ModuleSignalTest)
+
+
+BOOST_AUTO_TEST_CASE(MissingReplicaTest) {
+
+   BOOST_CHECK_EXCEPTION(
+     MyService(2U, [](std::size_t){ return std::unique_ptr<MyProvider>{}; }),
+     art::Exception,
+     [](art::Exception const& e)
+       { return e.categoryCode() == art::errors::Configuration; }
+     );
+
+} // BOOST_AUTO_TEST_CASE(MissingReplicaTest)
@@ -0,0 +1,109 @@
+/**
+ * @file   ServiceProviderWrappers_test.cc
+ * @brief  Tests the swappable providers in ServiceProviderWrappers.h
+ * @see    ServiceProviderWrappers.h
+ *
+ * This test takes no command line argument.
+ *
+ */
+
+#define BOOST_TEST_MODULE ( ServiceProviderWrappers_test )
+
+// LArSoft libraries
+#include "larcorealg/CoreUtils/UncopiableAndUnmovableClass.h"
+#include "larcore/CoreUtils/ServiceProviderWrappers.h"
+
+// Boost libraries
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// C/C++ standard libraries
+#include <atomic>
+#include <memory> // std::make_shared()
+#include <thread>
+#include <vector>
+
+
+//------------------------------------------------------------------------------
+struct MyProvider: protected lar::UncopiableAndUnmovableClass {
+
+   struct Config { int value = 0; };
+
+   int const value;
+
+   MyProvider(Config const& config): value(config.value) {}
+
+}; // MyProvider
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(SwappableProviderHolderTest) {
+
+   lar::SwappableProviderHolder<MyProvider> holder
+     { std::make_shared<MyProvider const>(MyProvider::Config{ 1 }) };
+   BOOST_TEST(holder.Generation() == 0U);
+   BOOST_TEST(holder.provider()->value == 1);
+
+   std::vector<int> reloaded;
+   holder.RegisterReloadCallback
+     ([&reloaded](MyProvider const& prov){ reloaded.push_back(prov.value); });
+
+   // a snapshot keeps the old provider alive after the replacement
+   auto const oldProvider = holder.providerSnapshot();
+   holder.Replace(std::make_shared<MyProvider const>(MyProvider::Config{ 2 }));
+   BOOST_TEST(holder.Generation() == 1U);
+   BOOST_TEST(holder.provider()->value == 2);
+   BOOST_TEST(oldProvider->value == 1);
+   BOOST_TEST(reloaded == std::vector<int>{ 2 });
+
+   // replaced providers are kept alive until explicitly released
+   std::weak_ptr<MyProvider const> const secondProvider
+     = holder.providerSnapshot();
+   holder.Replace(std::make_shared<MyProvider const>(MyProvider::Config{ 3 }));
+   BOOST_TEST(holder.Generation() == 2U);
+   BOOST_TEST(reloaded == (std::vector<int>{ 2, 3 }));
+   BOOST_TEST(holder.NRetired() == 2U);
+   BOOST_TEST(!secondProvider.expired());
+
+   holder.ReleaseRetired();
+   BOOST_TEST(holder.NRetired() == 0U);
+   BOOST_TEST(secondProvider.expired());
+   BOOST_TEST(oldProvider->value == 1);
+   BOOST_TEST(holder.provider()->value == 3);
+
+} // BOOST_AUTO_TEST_CASE(SwappableProviderHolderTest)
+
+
+BOOST_AUTO_TEST_CASE(ConcurrentReplaceTest) {
+
+   lar::SwappableProviderHolder<MyProvider> holder
+     { std::make_shared<MyProvider const>(MyProvider::Config{ 0 }) };
+
+   // readers must always see a complete provider, never an older one
+   constexpr int NReplacements = 1000;
+   std::atomic<bool> done { false };
+   std::atomic<unsigned int> errors { 0U };
+   std::vector<std::thread> readers;
+   for (unsigned int i = 0; i < 4; ++i) {
+     readers.emplace_back([&holder, &done, &errors](){
+       int last = 0;
+       while (!done.load()) {
+         int const value = holder.providerSnapshot()->value;
+         if (value < last) ++errors;
+         last = value;
+       } // while
+     });
+   } // for
+
+   for (int i = 1; i <= NReplacements; ++i)
+     holder.Replace(std::make_shared<MyProvider const>(MyProvider::Config{ i }));
+   done = true;
+   for (auto& reader: readers) reader.join();
+
+   BOOST_TEST(errors.load() == 0U);
+   BOOST_TEST(holder.Generation() == NReplacements);
+   BOOST_TEST(holder.provider()->value == NReplacements);
+   BOOST_TEST(holder.NRetired() == NReplacements);
+
+} // BOOST_AUTO_TEST_CASE(ConcurrentReplaceTest)
+
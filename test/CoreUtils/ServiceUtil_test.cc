@@ -218,4 +218,44 @@ BOOST_AUTO_TEST_CASE(providersFromTest) {
 
 
 
+BOOST_AUTO_TEST_CASE(cachedProviderFromTest) {
+
+   MyProvider prov;
+   MyOtherProvider oprov;
+   GlobalServices.myServicePtr = std::make_unique<MyService>(&prov);
+   GlobalServices.myOtherServicePtr = std::make_unique<MyOtherService>(&oprov);
+
+   BOOST_CHECK_EQUAL(lar::cachedProviderFrom<MyService>(), &prov);
+   BOOST_CHECK((lar::cachedProvidersFrom<MyService, MyOtherService>()
+     == lar::makeProviderPack(&prov, &oprov)));
+
+   // the service replaces its provider: the cache is still on the old one...
+   MyProvider newProv;
+   GlobalServices.myServicePtr = std::make_unique<MyService>(&newProv);
+   BOOST_CHECK_EQUAL(lar::cachedProviderFrom<MyService>(), &prov);
+
+   // ... until it is invalidated
+   lar::invalidateCachedProviders();
+   BOOST_CHECK_EQUAL(lar::cachedProviderFrom<MyService>(), &newProv);
+   BOOST_CHECK((lar::cachedProvidersFrom<MyService, MyOtherService>()
+     == lar::makeProviderPack(&newProv, &oprov)));
+
+   // a missing provider is not cached
+   GlobalServices.myServicePtr = std::make_unique<MyService>();
+   lar::invalidateCachedProviders();
+   BOOST_CHECK_EXCEPTION(lar::cachedProviderFrom<MyService>(), art::Exception,
+     [](art::Exception const& e)
+       { return e.categoryCode() == art::errors::NotFound; }
+     );
+   GlobalServices.myServicePtr = std::make_unique<MyService>(&prov);
+   BOOST_CHECK_EQUAL(lar::cachedProviderFrom<MyService>(), &prov);
+
+   // that's enough; let's clean up
+   GlobalServices.myServicePtr.reset();
+   GlobalServices.myOtherServicePtr.reset();
+
+} // BOOST_AUTO_TEST_CASE(cachedProviderFromTest)
+
+
+
 //------------------------------------------------------------------------------
@@ -0,0 +1,159 @@
+/**
+ * @file   AuxDetTestGeometryHelper_service.cc
+ * @brief  Auxiliary detector geometry helper for the tests.
+ * @see    test_geometry_stress_auxdet.fcl
+ *
+ * No experiment-agnostic implementation of `geo::AuxDetExptGeoHelperInterface`
+ * is shipped with LArSoft; this one serves the tests, which need one to run
+ * `geo::AuxDetGeometry`.
+ */
+
+// LArSoft includes
+#include "larcore/Geometry/AuxDetExptGeoHelperInterface.h"
+#include "larcorealg/Geometry/AuxDetChannelMapAlg.h"
+#include "larcorealg/Geometry/AuxDetGeometryCore.h"
+#include "larcorealg/Geometry/AuxDetGeo.h"
+
+// Framework includes
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// ROOT libraries
+#include "TVector3.h"
+
+// C/C++ standard library
+#include <memory> // std::make_unique()
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // uint32_t
+
+
+namespace geo {
+
+  /**
+   * @brief Channel mapping with one channel per sensitive volume.
+   *
+   * The channels of each auxiliary detector are numbered from `0` on,
+   * following the order of its sensitive volumes.
+   */
+  class AuxDetTestChannelMapAlg: public geo::AuxDetChannelMapAlg {
+      public:
+
+    void Initialize(geo::AuxDetGeometryData_t& geodata) override;
+
+    void Uninitialize() override;
+
+    uint32_t PositionToAuxDetChannel(
+      double const worldLoc[3], std::vector<geo::AuxDetGeo> const& auxDets,
+      size_t& ad, size_t& sv
+      ) const override;
+
+    const TVector3 AuxDetChannelToPosition(
+      uint32_t const& channel, std::string const& auxDetName,
+      std::vector<geo::AuxDetGeo> const& auxDets
+      ) const override;
+
+  }; // class AuxDetTestChannelMapAlg
+
+
+  /// Serves a `geo::AuxDetTestChannelMapAlg` to `geo::AuxDetGeometry`.
+  class AuxDetTestGeometryHelper: public geo::AuxDetExptGeoHelperInterface {
+      public:
+    explicit AuxDetTestGeometryHelper(fhicl::ParameterSet const&) {}
+
+      private:
+    AuxDetChannelMapAlgPtr_t doConfigureAuxDetChannelMapAlg
+      (fhicl::ParameterSet const& sortingParameters) const override;
+
+  }; // class AuxDetTestGeometryHelper
+
+} // namespace geo
+
+DECLARE_ART_SERVICE_INTERFACE_IMPL(geo::AuxDetTestGeometryHelper,
+                                   geo::AuxDetExptGeoHelperInterface,
+                                   SHARED)
+
+
+//******************************************************************************
+namespace geo {
+
+  //----------------------------------------------------------------------------
+  void AuxDetTestChannelMapAlg::Initialize(geo::AuxDetGeometryData_t& geodata)
+  {
+    Uninitialize();
+
+    std::vector<geo::AuxDetGeo> const& auxDets = geodata.auxDets;
+    for (std::size_t ad = 0; ad < auxDets.size(); ++ad) {
+      std::string const& name = auxDets[ad].Name();
+      fADGeoToName[ad] = name;
+      fNameToADGeo[name] = ad;
+      for (std::size_t sv = 0; sv < auxDets[ad].NSensitiveVolume(); ++sv)
+        fADGeoToChannelAndSV[ad].emplace_back(sv, sv);
+    } // for auxiliary detectors
+
+  } // AuxDetTestChannelMapAlg::Initialize()
+
+
+  //----------------------------------------------------------------------------
+  void AuxDetTestChannelMapAlg::Uninitialize()
+  {
+    fADGeoToName.clear();
+    fNameToADGeo.clear();
+    fADGeoToChannelAndSV.clear();
+  } // AuxDetTestChannelMapAlg::Uninitialize()
+
+
+  //----------------------------------------------------------------------------
+  uint32_t AuxDetTestChannelMapAlg::PositionToAuxDetChannel(
+    double const worldLoc[3], std::vector<geo::AuxDetGeo> const& auxDets,
+    size_t& ad, size_t& sv
+    ) const
+  {
+    // the sensitive volume is the channel
+    ad = NearestSensitiveAuxDet(worldLoc, auxDets, sv);
+    return static_cast<uint32_t>(sv);
+  } // AuxDetTestChannelMapAlg::PositionToAuxDetChannel()
+
+
+  //----------------------------------------------------------------------------
+  const TVector3 AuxDetTestChannelMapAlg::AuxDetChannelToPosition(
+    uint32_t const& channel, std::string const& auxDetName,
+    std::vector<geo::AuxDetGeo> const& auxDets
+    ) const
+  {
+    auto const iAD = fNameToADGeo.find(auxDetName);
+    if (iAD == fNameToADGeo.end()) {
+      throw cet::exception("AuxDetTestChannelMapAlg")
+        << "No auxiliary detector named '" << auxDetName << "'\n";
+    }
+    geo::AuxDetGeo const& auxDet = auxDets[iAD->second];
+    if (channel >= auxDet.NSensitiveVolume()) {
+      throw cet::exception("AuxDetTestChannelMapAlg")
+        << "No channel " << channel << " in auxiliary detector '"
+        << auxDetName << "'\n";
+    }
+
+    double const origin[3] = { 0.0, 0.0, 0.0 };
+    double center[3];
+    auxDet.SensitiveVolume(channel).LocalToWorld(origin, center);
+    return { center[0], center[1], center[2] };
+  } // AuxDetTestChannelMapAlg::AuxDetChannelToPosition()
+
+
+  //----------------------------------------------------------------------------
+  AuxDetTestGeometryHelper::AuxDetChannelMapAlgPtr_t
+  AuxDetTestGeometryHelper::doConfigureAuxDetChannelMapAlg
+    (fhicl::ParameterSet const& /* sortingParameters */) const
+  {
+    mf::LogInfo("AuxDetTestGeometryHelper")
+      << "Loading channel mapping: AuxDetTestChannelMapAlg";
+    return std::make_unique<geo::AuxDetTestChannelMapAlg>();
+  } // AuxDetTestGeometryHelper::doConfigureAuxDetChannelMapAlg()
+
+} // namespace geo
+
+
+DEFINE_ART_SERVICE_INTERFACE_IMPL(geo::AuxDetTestGeometryHelper,
+                                  geo::AuxDetExptGeoHelperInterface)
@@ -0,0 +1,300 @@
+/**
+ * @file   GeometryBenchmark_module.cc
+ * @brief  Measures the cost of loading and querying the geometry.
+ */
+
+// LArSoft includes
+#include "larcore/Geometry/Geometry.h"
+#include "larcore/Geometry/GeometryLoadProfiler.h"
+#include "larcore/Geometry/ChannelMapTable.h"
+#include "larcore/Geometry/WireGeometryTable.h"
+
+// Framework includes
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// C/C++ standard library
+#include <algorithm> // std::max()
+#include <chrono>
+#include <memory> // std::unique_ptr<>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace art { class Event; } // art::Event declaration
+
+namespace geo {
+
+  /**
+   * @brief Measures the performance of the geometry service.
+   *
+   * The module runs at the beginning of the job, and reports:
+   *
+   * * the time spent in the loading of the geometry, step by step, as
+   *   recorded by the geometry service itself (the service must be
+   *   configured with `ProfileLoading: true`);
+   * * the time spent in repeated full loops of queries:
+   *     * `ChannelToWire()` on all channels;
+   *     * `PlaneWireToChannel()` on all wires;
+   *     * iteration of all wire IDs (`IterateWireIDs()`);
+   *     * `OpDetGeoFromOpChannel()` on all valid optical channels;
+   *     * `WireIDsIntersect()` on a sample of pairs of wires from the first
+   *       two planes of the first TPC;
+   *   and, if the channel mapping tables are configured in the service
+   *   (`BuildChannelMapTable`), the same channel mapping queries on them;
+   *   if the wire geometry table is configured (`BuildWireGeometryTable`),
+   *   the same wire crossings computed in a single batch.
+   *
+   * Each result is written as a line in the output file, with the format:
+   *
+   *     <label>;<measurement>;<calls>;<time [s]>;<rate [1/s]>;<peak RSS [kiB]>
+   *
+   * where the peak resident memory is the one of the process at the end of
+   * the measurement. The same information is printed via message facility.
+   *
+   * Configuration parameters
+   * =========================
+   *
+   * - *Label* (string, default: detector name): label of the results
+   * - *Repetitions* (unsigned integer, default: 10): number of full loops for
+   *   each query measurement
+   * - *OutputFile* (string, default: `"geometry_benchmark.csv"`): name of the
+   *   file where results are written (overwritten)
+   */
+  class GeometryBenchmark: public art::EDAnalyzer {
+      public:
+    explicit GeometryBenchmark(fhicl::ParameterSet const& pset);
+
+    virtual void analyze(art::Event const&) override {}
+    virtual void beginJob() override;
+
+      private:
+
+    /// Result of a single measurement.
+    struct Result_t {
+      std::string name;        ///< Name of the measurement.
+      std::size_t calls = 0U;  ///< Number of queries.
+      double seconds = 0.0;    ///< Total time.
+      long peakRSS = 0;        ///< Peak resident memory [kiB].
+    }; // Result_t
+
+    std::string fLabel;        ///< Label of the results.
+    unsigned int fRepetitions; ///< Number of loops for each query.
+    std::string fOutputFile;   ///< Name of the output file.
+
+    /// Accumulates query results, so that queries are not optimized away.
+    double fChecksum = 0.0;
+
+    /// Runs `loop` for `fRepetitions` times and measures it.
+    template <typename Loop>
+    Result_t measure(std::string name, Loop loop);
+
+    /// Measures all the queries on the geometry.
+    std::vector<Result_t> measureQueries(geo::Geometry const& geom);
+
+    /// Writes the results into the output file and on screen.
+    void report(std::vector<Result_t> const& results) const;
+
+  }; // class GeometryBenchmark
+
+} // namespace geo
+
+
+//******************************************************************************
+namespace geo {
+
+  //......................................................................
+  GeometryBenchmark::GeometryBenchmark(fhicl::ParameterSet const& pset)
+    : EDAnalyzer(pset)
+    , fLabel      (pset.get<std::string> ("Label",       ""))
+    , fRepetitions(pset.get<unsigned int>("Repetitions", 10U))
+    , fOutputFile (pset.get<std::string> ("OutputFile",  "geometry_benchmark.csv"))
+  {
+  } // GeometryBenchmark::GeometryBenchmark()
+
+
+  //......................................................................
+  void GeometryBenchmark::beginJob()
+  {
+    art::ServiceHandle<geo::Geometry const> geom;
+    if (fLabel.empty()) fLabel = geom->DetectorName();
+
+    std::vector<Result_t> results;
+
+    // loading statistics, as collected by the service
+    geo::GeometryLoadProfiler const& profile = geom->LoadingProfile();
+    if (!profile.enabled()) {
+      mf::LogWarning("GeometryBenchmark")
+        << "Geometry service is not profiling its loading:"
+        " configure it with `ProfileLoading: true` to measure it.";
+    }
+    for (auto const& step: profile.Stats()) {
+      results.push_back
+        ({ "load: " + step.name, step.calls, step.totalTime, step.peakRSS });
+    }
+
+    for (Result_t& result: measureQueries(*geom))
+      results.push_back(std::move(result));
+
+    report(results);
+
+  } // GeometryBenchmark::beginJob()
+
+
+  //......................................................................
+  template <typename Loop>
+  GeometryBenchmark::Result_t GeometryBenchmark::measure
+    (std::string name, Loop loop)
+  {
+    using Clock_t = std::chrono::steady_clock;
+
+    Result_t result;
+    result.name = std::move(name);
+    auto const start = Clock_t::now();
+    for (unsigned int iRep = 0; iRep < fRepetitions; ++iRep)
+      result.calls += loop();
+    std::chrono::duration<double> const elapsed = Clock_t::now() - start;
+    result.seconds = elapsed.count();
+    result.peakRSS = geo::GeometryLoadProfiler::PeakRSS();
+    return result;
+  } // GeometryBenchmark::measure()
+
+
+  //......................................................................
+  auto GeometryBenchmark::measureQueries(geo::Geometry const& geom)
+    -> std::vector<Result_t>
+  {
+    std::vector<Result_t> results;
+
+    unsigned int const nChannels = geom.Nchannels();
+    std::vector<geo::WireID> wireIDs;
+    for (geo::WireID const& wireID: geom.IterateWireIDs())
+      wireIDs.push_back(wireID);
+
+    results.push_back(measure("ChannelToWire", [&](){
+      for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel)
+        fChecksum += geom.ChannelToWire(channel).size();
+      return nChannels;
+    }));
+
+    results.push_back(measure("PlaneWireToChannel", [&](){
+      for (geo::WireID const& wireID: wireIDs)
+        fChecksum += geom.PlaneWireToChannel(wireID);
+      return wireIDs.size();
+    }));
+
+    results.push_back(measure("IterateWireIDs", [&](){
+      std::size_t n = 0U;
+      for (geo::WireID const& wireID: geom.IterateWireIDs()) {
+        fChecksum += wireID.Wire;
+        ++n;
+      }
+      return n;
+    }));
+
+    results.push_back(measure("OpDetGeoFromOpChannel", [&](){
+      std::size_t n = 0U;
+      unsigned int const maxOpChannel = geom.MaxOpChannel();
+      for (unsigned int opChannel = 0; opChannel <= maxOpChannel; ++opChannel)
+      {
+        if (!geom.IsValidOpChannel(opChannel)) continue;
+        fChecksum += geom.OpDetGeoFromOpChannel(opChannel).GetCenter().X();
+        ++n;
+      }
+      return n;
+    }));
+
+    // sample of wire pairs from the first two planes of the first TPC
+    std::vector<geo::WireID> firstWires, secondWires;
+    geo::TPCID const tpcid { 0, 0 };
+    if (geom.HasTPC(tpcid) && (geom.Nplanes(tpcid) >= 2)) {
+      geo::PlaneID const firstPlane { tpcid, 0 }, secondPlane { tpcid, 1 };
+      std::size_t const nFirst = geom.Nwires(firstPlane);
+      std::size_t const nSecond = geom.Nwires(secondPlane);
+      std::size_t const stride
+        = std::max(nFirst * nSecond / 100000U, std::size_t{ 1U });
+      for (std::size_t i = 0; i < nFirst * nSecond; i += stride) {
+        firstWires.emplace_back(firstPlane, i / nSecond);
+        secondWires.emplace_back(secondPlane, i % nSecond);
+      }
+    } // if TPC has two planes
+
+    if (!firstWires.empty()) {
+      results.push_back(measure("WireIDsIntersect", [&](){
+        geo::WireIDIntersection crossing;
+        for (std::size_t i = 0; i < firstWires.size(); ++i) {
+          if (geom.WireIDsIntersect(firstWires[i], secondWires[i], crossing))
+            fChecksum += crossing.z;
+        }
+        return firstWires.size();
+      }));
+    }
+
+    geo::WireGeometryTable const* wireTable = geom.WireTable();
+    if (wireTable && !firstWires.empty()) {
+      std::size_t const nPairs = firstWires.size();
+      std::vector<double> y(nPairs), z(nPairs);
+      std::unique_ptr<bool[]> cross { new bool[nPairs] };
+      results.push_back(measure("WireCrossings (table)", [&](){
+        wireTable->WireCrossings(firstWires.data(), secondWires.data(),
+          nPairs, y.data(), z.data(), cross.get());
+        for (std::size_t i = 0; i < nPairs; ++i)
+          if (cross[i]) fChecksum += z[i];
+        return nPairs;
+      }));
+    }
+
+    geo::ChannelMapTable const* table = geom.ChannelTable();
+    if (!table) return results;
+
+    results.push_back(measure("ChannelToWire (table)", [&](){
+      for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel)
+        fChecksum += table->ChannelToWire(channel).size();
+      return nChannels;
+    }));
+
+    results.push_back(measure("PlaneWireToChannel (table)", [&](){
+      for (geo::WireID const& wireID: wireIDs)
+        fChecksum += table->PlaneWireToChannel(wireID);
+      return wireIDs.size();
+    }));
+
+    return results;
+  } // GeometryBenchmark::measureQueries()
+
+
+  //......................................................................
+  void GeometryBenchmark::report(std::vector<Result_t> const& results) const
+  {
+    std::ofstream out(fOutputFile);
+    if (!out) {
+      throw cet::exception("GeometryBenchmark")
+        << "Can't write benchmark results into '" << fOutputFile << "'\n";
+    }
+
+    mf::LogInfo log("GeometryBenchmark");
+    log << "Geometry benchmark results for '" << fLabel << "' ("
+      << fRepetitions << " repetitions, checksum: " << fChecksum << "):";
+    for (Result_t const& result: results) {
+      double const rate
+        = (result.seconds > 0.0)? (result.calls / result.seconds): 0.0;
+      out << fLabel << ';' << result.name << ';' << result.calls
+        << ';' << result.seconds << ';' << rate << ';' << result.peakRSS
+        << '\n';
+      log << "\n  " << result.name << ": " << result.calls << " calls in "
+        << result.seconds << " s (" << rate << " Hz), peak RSS "
+        << (result.peakRSS / 1024) << " MiB";
+    } // for
+  } // GeometryBenchmark::report()
+
+
+  //......................................................................
+  DEFINE_ART_MODULE(GeometryBenchmark)
+
+} // namespace geo
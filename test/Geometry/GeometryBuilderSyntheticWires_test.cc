@@ -0,0 +1,88 @@
+/**
+ * @file   GeometryBuilderSyntheticWires_test.cc
+ * @brief  Tests the wire layout of geo::GeometryBuilderSyntheticWires.
+ * @see    larcore/Geometry/GeometryBuilderSyntheticWires.h
+ *
+ * This test takes no command line argument.
+ * The reference values are the ones of the wires in `icarus.gdml`.
+ */
+
+#define BOOST_TEST_MODULE ( GeometryBuilderSyntheticWires_test )
+
+// LArSoft libraries
+#include "larcore/Geometry/GeometryBuilderSyntheticWires.h"
+
+// Boost libraries
+#include <cetlib/quiet_unit_test.hpp> // BOOST_AUTO_TEST_CASE()
+#include <boost/test/test_tools.hpp> // BOOST_CHECK(), BOOST_CHECK_EQUAL()
+
+// C/C++ standard libraries
+#include <cmath> // std::abs(), std::sin(), std::cos()
+
+
+//------------------------------------------------------------------------------
+using Builder_t = geo::GeometryBuilderSyntheticWires;
+
+constexpr double Deg = 3.14159265358979323846 / 180.0;
+constexpr double HalfY = 195.0; // cm
+constexpr double HalfZ = 995.0; // cm
+
+
+/// Checks that all wires are in the plane, one pitch apart.
+void CheckLayout(Builder_t::PlaneLayout_t const& layout) {
+
+  auto const wires = Builder_t::ComputeWires(layout, HalfY, HalfZ);
+  BOOST_TEST_REQUIRE(!wires.empty());
+
+  double const sinA = std::sin(layout.angle), cosA = std::cos(layout.angle);
+  double prevS = 0.0;
+  for (std::size_t iWire = 0; iWire < wires.size(); ++iWire) {
+    auto const& wire = wires[iWire];
+    BOOST_TEST(wire.halfLength > 0.0);
+    for (double const side: { -1.0, +1.0 }) {
+      double const y = wire.y + side * wire.halfLength * sinA;
+      double const z = wire.z + side * wire.halfLength * cosA;
+      BOOST_TEST(std::abs(y) <= HalfY + 1e-6);
+      BOOST_TEST(std::abs(z) <= HalfZ + 1e-6);
+    } // for
+    double const s = wire.y * cosA - wire.z * sinA;
+    if (iWire > 0)
+      BOOST_TEST(s - prevS == layout.pitch, boost::test_tools::tolerance(1e-6));
+    prevS = s;
+  } // for wires
+
+} // CheckLayout()
+
+
+//------------------------------------------------------------------------------
+BOOST_AUTO_TEST_CASE(InductionPlaneTest) {
+
+  Builder_t::PlaneLayout_t const layout
+    { "volTPCPlaneU", 0.3, 30.0 * Deg, 0.3, 0.0075 };
+  CheckLayout(layout);
+
+  auto const wires = Builder_t::ComputeWires(layout, HalfY, HalfZ);
+  BOOST_TEST(wires.size() == 4441U);
+  BOOST_TEST(wires.front().y == -194.826794919243,
+    boost::test_tools::tolerance(1e-9));
+  BOOST_TEST(wires.front().z == 994.7, boost::test_tools::tolerance(1e-9));
+
+} // InductionPlaneTest
+
+
+BOOST_AUTO_TEST_CASE(CollectionPlaneTest) {
+
+  Builder_t::PlaneLayout_t const layout
+    { "volTPCPlaneX", 0.3, 0.0, 0.1575, 0.0075 };
+  CheckLayout(layout);
+
+  auto const wires = Builder_t::ComputeWires(layout, HalfY, HalfZ);
+  BOOST_TEST(wires.size() == 1299U);
+  BOOST_TEST(wires.front().y == -194.8425, boost::test_tools::tolerance(1e-9));
+  BOOST_TEST(wires.back().y == 194.5575, boost::test_tools::tolerance(1e-9));
+  for (auto const& wire: wires) {
+    BOOST_TEST(std::abs(wire.z) < 1e-9);
+    BOOST_TEST(wire.halfLength == HalfZ, boost::test_tools::tolerance(1e-9));
+  }
+
+} // CollectionPlaneTest
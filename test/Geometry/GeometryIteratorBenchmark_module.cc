@@ -0,0 +1,232 @@
+/**
+ * @file   GeometryIteratorBenchmark_module.cc
+ * @brief  Compares loops with geometry iterators and with flat ID arrays.
+ * @see    GeometryIteratorLoopTest_module.cc
+ */
+
+// LArSoft includes
+#include "larcore/Geometry/Geometry.h"
+#include "larcore/Geometry/GeometryIDTable.h"
+
+// Framework includes
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// C/C++ standard library
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <utility> // std::move()
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace art { class Event; } // art::Event declaration
+
+namespace geo {
+
+  /**
+   * @brief Measures loops on all the geometry IDs.
+   *
+   * The module runs at the beginning of the job, and measures the time spent
+   * in full loops over all the cryostats, TPCs, planes and wires, using the
+   * geometry iterators (e.g. `IterateWireIDs()`) and the flat arrays of
+   * `geo::GeometryIDTable` (`IDTable()`). It also measures a loop on all the
+   * wires and their channels, as done by calibration code, with
+   * `PlaneWireToChannel()` and with the precomputed wire channels.
+   *
+   * While `GeometryIteratorLoopTest` checks that the iterators are correct,
+   * this module only checks that both loops visit the same number of
+   * elements.
+   *
+   * Results are written with the same format as `GeometryBenchmark`:
+   *
+   *     <label>;<measurement>;<calls>;<time [s]>;<rate [1/s]>;<peak RSS [kiB]>
+   *
+   * Configuration parameters
+   * =========================
+   *
+   * - *Label* (string, default: detector name): label of the results
+   * - *Repetitions* (unsigned integer, default: 100): number of full loops
+   *   for each measurement
+   * - *OutputFile* (string, default: `"geometry_iterator_benchmark.csv"`):
+   *   name of the file where results are written (overwritten)
+   */
+  class GeometryIteratorBenchmark: public art::EDAnalyzer {
+      public:
+    explicit GeometryIteratorBenchmark(fhicl::ParameterSet const& pset);
+
+    virtual void analyze(art::Event const&) override {}
+    virtual void beginJob() override;
+
+      private:
+
+    /// Result of a single measurement.
+    struct Result_t {
+      std::string name;        ///< Name of the measurement.
+      std::size_t calls = 0U;  ///< Number of visited elements.
+      double seconds = 0.0;    ///< Total time.
+    }; // Result_t
+
+    std::string fLabel;        ///< Label of the results.
+    unsigned int fRepetitions; ///< Number of loops for each measurement.
+    std::string fOutputFile;   ///< Name of the output file.
+
+    /// Accumulates loop results, so that loops are not optimized away.
+    std::size_t fChecksum = 0U;
+
+    /// Runs `loop` for `fRepetitions` times and measures it.
+    template <typename Loop>
+    Result_t measure(std::string name, Loop loop);
+
+    /// Measures and compares loops on iterators and on the flat `range`.
+    template <typename Range, typename FlatRange>
+    void compare(
+      std::vector<Result_t>& results, std::string const& name,
+      Range const& range, FlatRange const& flatRange
+      );
+
+    /// Writes the results into the output file and on screen.
+    void report(std::vector<Result_t> const& results) const;
+
+  }; // class GeometryIteratorBenchmark
+
+} // namespace geo
+
+
+//******************************************************************************
+namespace geo {
+
+  //......................................................................
+  GeometryIteratorBenchmark::GeometryIteratorBenchmark
+    (fhicl::ParameterSet const& pset)
+    : EDAnalyzer(pset)
+    , fLabel      (pset.get<std::string> ("Label",       ""))
+    , fRepetitions(pset.get<unsigned int>("Repetitions", 100U))
+    , fOutputFile (pset.get<std::string>
+                     ("OutputFile", "geometry_iterator_benchmark.csv"))
+  {
+  } // GeometryIteratorBenchmark::GeometryIteratorBenchmark()
+
+
+  //......................................................................
+  void GeometryIteratorBenchmark::beginJob()
+  {
+    art::ServiceHandle<geo::Geometry const> geom;
+    if (fLabel.empty()) fLabel = geom->DetectorName();
+
+    geo::GeometryIDTable const& table = *(geom->IDTable());
+
+    std::vector<Result_t> results;
+
+    compare(results, "cryostats",
+      geom->IterateCryostatIDs(), table.Cryostats());
+    compare(results, "TPCs", geom->IterateTPCIDs(), table.TPCs());
+    compare(results, "planes", geom->IteratePlaneIDs(), table.Planes());
+    compare(results, "wires", geom->IterateWireIDs(), table.Wires());
+
+    results.push_back(measure("wire channels (iterator)", [&](){
+      std::size_t n = 0U;
+      for (geo::WireID const& wireID: geom->IterateWireIDs()) {
+        fChecksum += geom->PlaneWireToChannel(wireID);
+        ++n;
+      }
+      return n;
+    }));
+
+    results.push_back(measure("wire channels (flat)", [&](){
+      for (raw::ChannelID_t const channel: table.WireChannels())
+        fChecksum += channel;
+      return table.WireChannels().size();
+    }));
+
+    report(results);
+
+  } // GeometryIteratorBenchmark::beginJob()
+
+
+  //......................................................................
+  template <typename Loop>
+  GeometryIteratorBenchmark::Result_t GeometryIteratorBenchmark::measure
+    (std::string name, Loop loop)
+  {
+    using Clock_t = std::chrono::steady_clock;
+
+    Result_t result;
+    result.name = std::move(name);
+    auto const start = Clock_t::now();
+    for (unsigned int iRep = 0; iRep < fRepetitions; ++iRep)
+      result.calls += loop();
+    std::chrono::duration<double> const elapsed = Clock_t::now() - start;
+    result.seconds = elapsed.count();
+    return result;
+  } // GeometryIteratorBenchmark::measure()
+
+
+  //......................................................................
+  template <typename Range, typename FlatRange>
+  void GeometryIteratorBenchmark::compare(
+    std::vector<Result_t>& results, std::string const& name,
+    Range const& range, FlatRange const& flatRange
+  ) {
+    // the validity flag is the only content shared by all the ID types
+    results.push_back(measure(name + " (iterator)", [&](){
+      std::size_t n = 0U;
+      for (auto const& id: range) {
+        fChecksum += id.isValid;
+        ++n;
+      }
+      return n;
+    }));
+    results.push_back(measure(name + " (flat)", [&](){
+      std::size_t n = 0U;
+      for (auto const& id: flatRange) {
+        fChecksum += id.isValid;
+        ++n;
+      }
+      return n;
+    }));
+
+    Result_t const& flat = results.back();
+    Result_t const& iter = results[results.size() - 2];
+    if (flat.calls != iter.calls) {
+      throw cet::exception("GeometryIteratorBenchmark")
+        << "Loops on " << name << " visited " << iter.calls
+        << " elements with iterators, " << flat.calls << " with flat arrays\n";
+    }
+  } // GeometryIteratorBenchmark::compare()
+
+
+  //......................................................................
+  void GeometryIteratorBenchmark::report
+    (std::vector<Result_t> const& results) const
+  {
+    std::ofstream out(fOutputFile);
+    if (!out) {
+      throw cet::exception("GeometryIteratorBenchmark")
+        << "Can't write benchmark results into '" << fOutputFile << "'\n";
+    }
+
+    long const peakRSS = geo::GeometryLoadProfiler::PeakRSS();
+    mf::LogInfo log("GeometryIteratorBenchmark");
+    log << "Geometry iterator benchmark results for '" << fLabel << "' ("
+      << fRepetitions << " repetitions, checksum: " << fChecksum << "):";
+    for (Result_t const& result: results) {
+      double const rate
+        = (result.seconds > 0.0)? (result.calls / result.seconds): 0.0;
+      out << fLabel << ';' << result.name << ';' << result.calls
+        << ';' << result.seconds << ';' << rate << ';' << peakRSS << '\n';
+      log << "\n  " << result.name << ": " << result.calls << " elements in "
+        << result.seconds << " s (" << rate << " Hz)";
+    } // for
+  } // GeometryIteratorBenchmark::report()
+
+
+  //......................................................................
+  DEFINE_ART_MODULE(GeometryIteratorBenchmark)
+
+} // namespace geo
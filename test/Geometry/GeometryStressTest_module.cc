@@ -0,0 +1,433 @@
+/**
+ * @file   GeometryStressTest_module.cc
+ * @brief  Queries the geometry concurrently from many schedules and tasks.
+ */
+
+// LArSoft includes
+#include "larcore/Geometry/Geometry.h"
+#include "larcore/Geometry/AuxDetGeometry.h"
+#include "larcore/Geometry/GeometryIDTable.h"
+#include "larcore/Geometry/GeometrySourceRegistry.h"
+
+// Framework includes
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Core/SharedAnalyzer.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Run.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// TBB libraries
+#include "tbb/parallel_for.h"
+
+// C/C++ standard library
+#include <algorithm> // std::min(), std::max()
+#include <atomic>
+#include <chrono>
+#include <memory> // std::shared_ptr<>
+#include <utility> // std::pair<>
+#include <vector>
+#include <cstddef> // std::size_t
+#include <cstdint> // std::uint64_t
+
+
+namespace geo {
+
+  /**
+   * @brief Stresses the geometry service with concurrent queries.
+   *
+   * This analyzer is meant to be run with many art schedules and threads.
+   * On each event, it spawns a number of TBB tasks, each of which runs
+   * on a slice of the detector:
+   *
+   * * `ChannelToWire()` on a slice of the channels;
+   * * `PlaneWireToChannel()` on a slice of the wires;
+   * * a full iteration of the plane IDs (`IteratePlaneIDs()`);
+   * * `PositionToTPCID()` and `IndexedPositionToTPCID()` on a slice of a grid
+   *   of points covering all the TPCs;
+   *
+   * and compares a checksum of the results with the one computed on a single
+   * thread at the beginning of the run. Any difference means that concurrent
+   * queries interfered with each other, or that the geometry changed while
+   * events were being processed; the same happens if the generation of the
+   * geometry (`geo::Geometry::Generation()`) changes within a run.
+   * Each point must also be located in the same TPC by `PositionToTPCID()`
+   * and by `IndexedPositionToTPCID()`.
+   * Reference results are computed again on each run if the geometry has
+   * changed: running on input with a different detector in each run (see the
+   * `sumdata::RunData` product, and `geo::RunDataMaker`) also exercises the
+   * reloading of the geometry at run boundaries.
+   *
+   * At the end of the job, the number of queries and their rate are printed,
+   * and an exception is thrown if any difference was detected. For a more
+   * thorough detection of data races, the job can be run under a thread
+   * sanitizer.
+   *
+   * Configuration parameters
+   * =========================
+   *
+   * - *TasksPerEvent* (unsigned integer, default: 8): number of slices (and
+   *   TBB tasks) the queries of each event are split into
+   * - *PointsPerSide* (unsigned integer, default: 10): points per side of the
+   *   cubic grid of points sampled in (and around) each TPC
+   * - *ExpectedLoadings* (integer, default: no check): number of geometry
+   *   loadings expected in the job, including the one at construction
+   * - *ExpectedDescriptionBuilds* (integer, default: no check): number of
+   *   loadings expected to build the geometry description, rather than to
+   *   reuse the one already loaded
+   * - *CheckAuxDetGeometry* (boolean, default: false): at the beginning of
+   *   each run, checks that `geo::AuxDetGeometry` describes the same detector
+   *   as `geo::Geometry`, and that neither of them is left with a ROOT
+   *   geometry replaced by the other (see `geo::GeometrySourceRegistry`)
+   *
+   * The last two checks use the loading profile of the geometry service,
+   * which must then have `ProfileLoading` enabled.
+   */
+  class GeometryStressTest: public art::SharedAnalyzer {
+      public:
+    explicit GeometryStressTest
+      (fhicl::ParameterSet const& pset, art::ProcessingFrame const&);
+
+    void beginRun(art::Run const&, art::ProcessingFrame const&) override;
+    void analyze(art::Event const& event, art::ProcessingFrame const&)
+      override;
+    void endJob(art::ProcessingFrame const&) override;
+
+      private:
+
+    /// Results expected from a geometry.
+    struct Reference_t {
+      std::uint64_t generation = 0U; ///< Generation of the geometry.
+      std::vector<geo::Point_t> points; ///< Points to locate.
+      std::vector<std::uint64_t> checksums; ///< Checksum of each slice.
+      std::uint64_t mismatches = 0U; ///< Points located in different TPCs.
+    }; // Reference_t
+
+    unsigned int fTasksPerEvent; ///< Number of slices of queries per event.
+    unsigned int fPointsPerSide; ///< Points per side of the grid in a TPC.
+    int fExpectedLoadings; ///< Expected geometry loadings (`-1`: any).
+    int fExpectedDescriptionBuilds; ///< Expected builds (`-1`: any).
+    bool fCheckAuxDetGeometry; ///< Whether to check `geo::AuxDetGeometry`.
+
+    /// Reference results for the current geometry.
+    std::shared_ptr<Reference_t const> fReference;
+
+    std::atomic<std::uint64_t> fNQueries { 0U }; ///< Queries performed.
+    std::atomic<std::uint64_t> fNTasks { 0U }; ///< Tasks run.
+    std::atomic<std::uint64_t> fNFailures { 0U }; ///< Checksum mismatches.
+    std::atomic<std::uint64_t> fNanoseconds { 0U }; ///< Time in queries.
+
+    /// Computes the reference results of the current geometry.
+    std::shared_ptr<Reference_t const> makeReference
+      (geo::Geometry const& geom) const;
+
+    /**
+     * @brief Runs the queries of `slice`.
+     * @return the checksum of the results
+     *
+     * The number of queries is added to `nQueries`, and the number of points
+     * located in different TPCs by the two location methods to `nMismatches`.
+     */
+    std::uint64_t runSlice(
+      geo::Geometry const& geom, Reference_t const& ref, unsigned int slice,
+      std::uint64_t& nQueries, std::uint64_t& nMismatches
+      ) const;
+
+    /// Returns the number of inconsistencies of the two geometry services.
+    unsigned int checkAuxDetGeometry
+      (geo::Geometry const& geom, art::Run const& run) const;
+
+    /// Returns the number of mismatches with the expected loading counts.
+    unsigned int checkLoadings(geo::Geometry const& geom) const;
+
+    /// Combines `value` into the `checksum`.
+    static void mix(std::uint64_t& checksum, std::uint64_t value)
+      { checksum = (checksum ^ value) * 1099511628211ULL; }
+
+    /// Returns whether `a` and `b` are both invalid or the same TPC.
+    static bool sameTPC(geo::TPCID const& a, geo::TPCID const& b)
+      { return (a.isValid == b.isValid) && (!a.isValid || (a == b)); }
+
+    /// Returns the range of elements of `slice` out of `n` elements.
+    std::pair<std::size_t, std::size_t> sliceRange
+      (std::size_t n, unsigned int slice) const;
+
+  }; // class GeometryStressTest
+
+} // namespace geo
+
+
+//******************************************************************************
+namespace geo {
+
+  //......................................................................
+  GeometryStressTest::GeometryStressTest
+    (fhicl::ParameterSet const& pset, art::ProcessingFrame const&)
+    : SharedAnalyzer(pset)
+    , fTasksPerEvent
+        (std::max(pset.get<unsigned int>("TasksPerEvent", 8U), 1U))
+    , fPointsPerSide(pset.get<unsigned int>("PointsPerSide", 10U))
+    , fExpectedLoadings(pset.get<int>("ExpectedLoadings", -1))
+    , fExpectedDescriptionBuilds(pset.get<int>("ExpectedDescriptionBuilds", -1))
+    , fCheckAuxDetGeometry(pset.get<bool>("CheckAuxDetGeometry", false))
+  {
+    if (((fExpectedLoadings >= 0) || (fExpectedDescriptionBuilds >= 0))
+      && !art::ServiceHandle<geo::Geometry const>()->LoadingProfile().enabled())
+    {
+      throw cet::exception("GeometryStressTest")
+        << "Checking the geometry loadings requires"
+        " `services.Geometry.ProfileLoading` to be enabled.\n";
+    }
+    async<art::InEvent>();
+  } // GeometryStressTest::GeometryStressTest()
+
+
+  //......................................................................
+  void GeometryStressTest::beginRun
+    (art::Run const& run, art::ProcessingFrame const&)
+  {
+    // `sPreBeginRun` has already happened, and no event is in flight
+    art::ServiceHandle<geo::Geometry const> geom;
+    if (fCheckAuxDetGeometry) fNFailures += checkAuxDetGeometry(*geom, run);
+
+    auto reference = std::atomic_load(&fReference);
+    if (reference && (reference->generation == geom->Generation())) return;
+
+    reference = makeReference(*geom);
+    std::atomic_store(&fReference, reference);
+    mf::LogInfo("GeometryStressTest") << "Reference results for "
+      << geom->DetectorName() << " (generation " << geom->Generation()
+      << ") computed at the start of run " << run.run();
+    if (reference->mismatches > 0U) {
+      fNFailures += reference->mismatches;
+      mf::LogError("GeometryStressTest") << reference->mismatches
+        << " points located in different TPCs by PositionToTPCID()"
+        " and IndexedPositionToTPCID() in run " << run.run();
+    }
+  } // GeometryStressTest::beginRun()
+
+
+  //......................................................................
+  void GeometryStressTest::analyze
+    (art::Event const& event, art::ProcessingFrame const&)
+  {
+    using Clock_t = std::chrono::steady_clock;
+
+    art::ServiceHandle<geo::Geometry const> geom;
+    auto const reference = std::atomic_load(&fReference);
+    Reference_t const& ref = *reference;
+
+    if (geom->Generation() != ref.generation) {
+      ++fNFailures;
+      mf::LogError("GeometryStressTest") << "Geometry generation changed from "
+        << ref.generation << " to " << geom->Generation() << " within run "
+        << event.run();
+      return;
+    }
+
+    // each event starts from a different slice
+    unsigned int const firstSlice = event.event() % fTasksPerEvent;
+
+    auto const start = Clock_t::now();
+    tbb::parallel_for(0U, fTasksPerEvent, [&](unsigned int iTask){
+      unsigned int const slice = (firstSlice + iTask) % fTasksPerEvent;
+      std::uint64_t nQueries = 0U, nMismatches = 0U;
+      std::uint64_t const checksum
+        = runSlice(*geom, ref, slice, nQueries, nMismatches);
+      fNQueries += nQueries;
+      ++fNTasks;
+      if (nMismatches > 0U) {
+        fNFailures += nMismatches;
+        mf::LogError("GeometryStressTest") << "Event " << event.id()
+          << ": " << nMismatches << " points of slice #" << slice
+          << " located in different TPCs by the two methods";
+      }
+      if (checksum != ref.checksums[slice]) {
+        ++fNFailures;
+        mf::LogError("GeometryStressTest") << "Event " << event.id()
+          << ": results of slice #" << slice << " differ from reference";
+      }
+    });
+    fNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>
+      (Clock_t::now() - start).count();
+
+  } // GeometryStressTest::analyze()
+
+
+  //......................................................................
+  void GeometryStressTest::endJob(art::ProcessingFrame const&)
+  {
+    fNFailures += checkLoadings(*art::ServiceHandle<geo::Geometry const>());
+
+    double const seconds = fNanoseconds.load() * 1e-9;
+    double const rate = (seconds > 0.0)? (fNQueries.load() / seconds): 0.0;
+    mf::LogInfo("GeometryStressTest") << fNQueries.load()
+      << " geometry queries in " << fNTasks.load() << " tasks, "
+      << seconds << " s in events (" << rate << " Hz); "
+      << fNFailures.load() << " failures";
+
+    if (fNFailures.load() > 0U) {
+      throw cet::exception("GeometryStressTest")
+        << fNFailures.load()
+        << " geometry checks failed (see the error messages).\n";
+    }
+  } // GeometryStressTest::endJob()
+
+
+  //......................................................................
+  unsigned int GeometryStressTest::checkAuxDetGeometry
+    (geo::Geometry const& geom, art::Run const& run) const
+  {
+    auto const auxDetSnapshot
+      = art::ServiceHandle<geo::AuxDetGeometry const>()->Snapshot();
+    auto const& registry = geo::GeometrySourceRegistry::Instance();
+
+    unsigned int nMismatches = 0U;
+    if (auxDetSnapshot->DetectorName() != geom.DetectorName()) {
+      ++nMismatches;
+      mf::LogError("GeometryStressTest") << "In run " << run.run()
+        << " AuxDetGeometry describes '" << auxDetSnapshot->DetectorName()
+        << "' while Geometry describes '" << geom.DetectorName() << "'";
+    }
+    for (char const* client: { "Geometry", "AuxDetGeometry" }) {
+      if (!registry.IsStale(client)) continue;
+      ++nMismatches;
+      mf::LogError("GeometryStressTest") << "In run " << run.run()
+        << " the ROOT geometry of " << client
+        << " was replaced and not loaded again";
+    } // for
+    return nMismatches;
+  } // GeometryStressTest::checkAuxDetGeometry()
+
+
+  //......................................................................
+  unsigned int GeometryStressTest::checkLoadings
+    (geo::Geometry const& geom) const
+  {
+    unsigned int loadings = 0U, descriptionBuilds = 0U;
+    for (auto const& step: geom.LoadingProfile().Stats()) {
+      if (step.name == "total loading") loadings = step.calls;
+      else if (step.name == "geometry description")
+        descriptionBuilds = step.calls;
+    } // for
+
+    unsigned int nMismatches = 0U;
+    if ((fExpectedLoadings >= 0)
+      && (loadings != static_cast<unsigned int>(fExpectedLoadings)))
+    {
+      ++nMismatches;
+      mf::LogError("GeometryStressTest") << "The geometry was loaded "
+        << loadings << " times, " << fExpectedLoadings << " expected";
+    }
+    if ((fExpectedDescriptionBuilds >= 0) && (descriptionBuilds
+      != static_cast<unsigned int>(fExpectedDescriptionBuilds)))
+    {
+      ++nMismatches;
+      mf::LogError("GeometryStressTest") << "The geometry description was"
+        " built " << descriptionBuilds << " times, "
+        << fExpectedDescriptionBuilds << " expected";
+    }
+    return nMismatches;
+  } // GeometryStressTest::checkLoadings()
+
+
+  //......................................................................
+  auto GeometryStressTest::makeReference(geo::Geometry const& geom) const
+    -> std::shared_ptr<Reference_t const>
+  {
+    auto ref = std::make_shared<Reference_t>();
+    ref->generation = geom.Generation();
+
+    // a grid on each TPC, extending a bit beyond its borders
+    unsigned int const n = fPointsPerSide;
+    for (geo::TPCGeo const& tpc: geom.IterateTPCs()) {
+      double const dx = (tpc.MaxX() - tpc.MinX()) * 1.2 / (n + 1);
+      double const dy = (tpc.MaxY() - tpc.MinY()) * 1.2 / (n + 1);
+      double const dz = (tpc.MaxZ() - tpc.MinZ()) * 1.2 / (n + 1);
+      double const x0 = tpc.MinX() - (tpc.MaxX() - tpc.MinX()) * 0.1;
+      double const y0 = tpc.MinY() - (tpc.MaxY() - tpc.MinY()) * 0.1;
+      double const z0 = tpc.MinZ() - (tpc.MaxZ() - tpc.MinZ()) * 0.1;
+      for (unsigned int i = 1; i <= n; ++i)
+        for (unsigned int j = 1; j <= n; ++j)
+          for (unsigned int k = 1; k <= n; ++k)
+            ref->points.emplace_back(x0 + i * dx, y0 + j * dy, z0 + k * dz);
+    } // for TPC
+
+    for (unsigned int slice = 0; slice < fTasksPerEvent; ++slice) {
+      std::uint64_t nQueries = 0U;
+      ref->checksums.push_back
+        (runSlice(geom, *ref, slice, nQueries, ref->mismatches));
+    }
+    return ref;
+  } // GeometryStressTest::makeReference()
+
+
+  //......................................................................
+  std::uint64_t GeometryStressTest::runSlice(
+    geo::Geometry const& geom, Reference_t const& ref, unsigned int slice,
+    std::uint64_t& nQueries, std::uint64_t& nMismatches
+  ) const {
+    std::uint64_t checksum = 14695981039346656037ULL;
+    auto mixID = [&checksum](geo::WireID const& wid) {
+      mix(checksum, wid.Cryostat);
+      mix(checksum, wid.TPC);
+      mix(checksum, wid.Plane);
+      mix(checksum, wid.Wire);
+    };
+    auto mixTPCID = [&checksum](geo::TPCID const& tpcid) {
+      mix(checksum, tpcid.isValid);
+      if (!tpcid.isValid) return;
+      mix(checksum, tpcid.Cryostat);
+      mix(checksum, tpcid.TPC);
+    };
+
+    auto const [ firstChannel, endChannel ]
+      = sliceRange(geom.Nchannels(), slice);
+    for (std::size_t channel = firstChannel; channel < endChannel; ++channel) {
+      for (geo::WireID const& wid: geom.ChannelToWire(channel)) mixID(wid);
+      ++nQueries;
+    }
+
+    auto const wires = geom.IDTable()->Wires();
+    auto const [ firstWire, endWire ] = sliceRange(wires.size(), slice);
+    for (std::size_t iWire = firstWire; iWire < endWire; ++iWire) {
+      mix(checksum, geom.PlaneWireToChannel(wires[iWire]));
+      ++nQueries;
+    }
+
+    for (geo::PlaneID const& pid: geom.IteratePlaneIDs()) {
+      mix(checksum, pid.Plane);
+      ++nQueries;
+    }
+
+    auto const [ firstPoint, endPoint ] = sliceRange(ref.points.size(), slice);
+    for (std::size_t iPoint = firstPoint; iPoint < endPoint; ++iPoint) {
+      geo::Point_t const& point = ref.points[iPoint];
+      geo::TPCID const tpcid = geom.PositionToTPCID(point);
+      geo::TPCID const indexedTPCID = geom.IndexedPositionToTPCID(point);
+      mixTPCID(tpcid);
+      mixTPCID(indexedTPCID);
+      if (!sameTPC(tpcid, indexedTPCID)) ++nMismatches;
+      nQueries += 2;
+    }
+
+    return checksum;
+  } // GeometryStressTest::runSlice()
+
+
+  //......................................................................
+  std::pair<std::size_t, std::size_t> GeometryStressTest::sliceRange
+    (std::size_t n, unsigned int slice) const
+  {
+    std::size_t const sliceSize = (n + fTasksPerEvent - 1) / fTasksPerEvent;
+    std::size_t const begin = std::min(n, slice * sliceSize);
+    return { begin, std::min(n, begin + sliceSize) };
+  } // GeometryStressTest::sliceRange()
+
+
+  //......................................................................
+  DEFINE_ART_MODULE(GeometryStressTest)
+
+} // namespace geo
@@ -0,0 +1,362 @@
+/**
+ * @file   GeometryTablesTest_module.cc
+ * @brief  Compares the precomputed geometry tables with the geometry queries.
+ * @see    test_geometry_tables.fcl
+ */
+
+// LArSoft includes
+#include "larcore/Geometry/Geometry.h"
+#include "larcore/Geometry/GeometrySnapshot.h"
+#include "larcore/Geometry/ChannelMapTable.h"
+#include "larcore/Geometry/WireGeometryTable.h"
+#include "larcorealg/Geometry/GeometryCore.h"
+
+// Framework includes
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Core/EDAnalyzer.h"
+#include "art/Framework/Principal/Run.h"
+#include "art/Framework/Services/Registry/ServiceHandle.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// C/C++ standard library
+#include <algorithm> // std::max(), std::min()
+#include <memory> // std::unique_ptr<>
+#include <vector>
+#include <cmath> // std::abs(), std::hypot(), std::isfinite()
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  /**
+   * @brief Checks the precomputed tables against the geometry provider.
+   *
+   * At the beginning of each run, the channel mapping tables
+   * (`geo::ChannelMapTable`, enabled by `BuildChannelMapTable`) are compared
+   * with the channel mapping of the `geo::GeometryCore` provider:
+   *
+   * * `ChannelToWire()` and `View()` on every channel;
+   * * `PlaneWireToChannel()` on every wire;
+   * * the batch versions of the same queries (`ChannelsToWires()`,
+   *   `ChannelsToViews()` and `WiresToChannels()`) on all channels and wires.
+   *
+   * Then, the batch wire crossings of the wire geometry table
+   * (`geo::WireGeometryTable::WireCrossings()`, enabled by
+   * `BuildWireGeometryTable`) are compared with
+   * `geo::GeometryCore::WireIDsIntersect()` on a sample of pairs of wires
+   * from each pair of planes of each TPC: the crossing points must match
+   * within a tolerance, and so must the crossing flags, unless the crossing is
+   * within tolerance from the end of one of the wires.
+   *
+   * Any difference is reported via message facility (category
+   * `GeometryTablesTest`), and an exception is thrown at the end of the check.
+   *
+   * Configuration parameters
+   * =========================
+   *
+   * - *MaxErrorMessages* (unsigned integer, default: 20): number of
+   *   differences reported in detail in each run
+   * - *WirePairsPerPlanePair* (unsigned integer, default: 2000): number of
+   *   pairs of wires sampled from each pair of planes
+   * - *Tolerance* (real, default: 1e-4): largest difference [cm] of crossing
+   *   point coordinates
+   */
+  class GeometryTablesTest: public art::EDAnalyzer {
+      public:
+    explicit GeometryTablesTest(fhicl::ParameterSet const& pset);
+
+    void beginRun(art::Run const& run) override;
+    void analyze(art::Event const&) override {}
+
+      private:
+
+    unsigned int fMaxErrorMessages; ///< Differences reported in detail.
+    unsigned int fWirePairsPerPlanePair; ///< Wire pairs from each plane pair.
+    double fTolerance; ///< Largest crossing coordinate difference [cm].
+
+    unsigned int fNErrors = 0U; ///< Differences found in the current check.
+
+    /// Compares the channel mapping tables with the provider.
+    void checkChannelMapTable
+      (geo::GeometryCore const& geom, geo::ChannelMapTable const& table);
+
+    /// Compares the batch wire crossings with the provider.
+    void checkWireCrossings
+      (geo::GeometryCore const& geom, geo::WireGeometryTable const& table);
+
+    /// Returns the distance of `(y, z)` from the closest end of `wire` [cm].
+    static double distanceFromEnd
+      (geo::WireGeo const& wire, double y, double z);
+
+    /// Records a difference; returns whether to describe it.
+    bool newError() { return fNErrors++ < fMaxErrorMessages; }
+
+    /// Returns whether `wires` matches `expected` exactly.
+    template <typename Range>
+    static bool sameWires
+      (Range const& wires, std::vector<geo::WireID> const& expected);
+
+  }; // class GeometryTablesTest
+
+} // namespace geo
+
+
+//******************************************************************************
+namespace geo {
+
+  //......................................................................
+  GeometryTablesTest::GeometryTablesTest(fhicl::ParameterSet const& pset)
+    : EDAnalyzer(pset)
+    , fMaxErrorMessages(pset.get<unsigned int>("MaxErrorMessages", 20U))
+    , fWirePairsPerPlanePair
+        (pset.get<unsigned int>("WirePairsPerPlanePair", 2000U))
+    , fTolerance(pset.get<double>("Tolerance", 1e-4))
+    {}
+
+
+  //......................................................................
+  void GeometryTablesTest::beginRun(art::Run const& run) {
+    art::ServiceHandle<geo::Geometry const> geomService;
+    geo::GeometryCore const& geom = *(geomService->provider());
+    auto const snapshot = geomService->Snapshot();
+
+    geo::ChannelMapTable const* channelTable = snapshot->ChannelTable();
+    if (!channelTable) {
+      throw cet::exception("GeometryTablesTest")
+        << "The channel mapping tables are not available:"
+        " `services.Geometry.BuildChannelMapTable` must be enabled.\n";
+    }
+    geo::WireGeometryTable const* wireTable = snapshot->WireTable();
+    if (!wireTable) {
+      throw cet::exception("GeometryTablesTest")
+        << "The wire geometry table is not available:"
+        " `services.Geometry.BuildWireGeometryTable` must be enabled.\n";
+    }
+
+    fNErrors = 0U;
+    checkChannelMapTable(geom, *channelTable);
+    checkWireCrossings(geom, *wireTable);
+
+    if (fNErrors > 0U) {
+      throw cet::exception("GeometryTablesTest") << fNErrors
+        << " differences between the geometry tables and the geometry of '"
+        << geom.DetectorName() << "' in run " << run.run()
+        << " (see the error messages).\n";
+    }
+    mf::LogInfo("GeometryTablesTest") << "Geometry tables of '"
+      << geom.DetectorName() << "' match the geometry in run " << run.run();
+
+  } // GeometryTablesTest::beginRun()
+
+
+  //......................................................................
+  void GeometryTablesTest::checkChannelMapTable
+    (geo::GeometryCore const& geom, geo::ChannelMapTable const& table)
+  {
+    unsigned int const nChannels = geom.Nchannels();
+    if (table.Nchannels() != nChannels) {
+      if (newError()) {
+        mf::LogError("GeometryTablesTest") << "The channel table has "
+          << table.Nchannels() << " channels, the geometry " << nChannels;
+      }
+      return;
+    }
+
+    std::vector<raw::ChannelID_t> channels;
+    std::vector<std::vector<geo::WireID>> channelWires;
+    for (raw::ChannelID_t channel = 0; channel < nChannels; ++channel) {
+      channels.push_back(channel);
+      channelWires.push_back(geom.ChannelToWire(channel));
+
+      if (!sameWires(table.ChannelToWire(channel), channelWires.back())
+        && newError())
+      {
+        mf::LogError("GeometryTablesTest") << "ChannelToWire(" << channel
+          << "): " << table.ChannelToWire(channel).size()
+          << " wires from the table, " << channelWires.back().size()
+          << " from the geometry, or different wires";
+      }
+      if ((table.View(channel) != geom.View(channel)) && newError()) {
+        mf::LogError("GeometryTablesTest") << "View(" << channel << "): "
+          << table.View(channel) << " from the table, "
+          << geom.View(channel) << " from the geometry";
+      }
+    } // for channels
+
+    std::vector<geo::WireID> wireIDs;
+    std::vector<raw::ChannelID_t> wireChannels;
+    for (geo::WireID const& wireID: geom.IterateWireIDs()) {
+      wireIDs.push_back(wireID);
+      wireChannels.push_back(geom.PlaneWireToChannel(wireID));
+      if ((table.PlaneWireToChannel(wireID) != wireChannels.back())
+        && newError())
+      {
+        mf::LogError("GeometryTablesTest") << "PlaneWireToChannel("
+          << wireID << "): " << table.PlaneWireToChannel(wireID)
+          << " from the table, " << wireChannels.back() << " from the geometry";
+      }
+    } // for wires
+
+    // batch queries
+    std::size_t const nWires
+      = table.NChannelWires(channels.data(), channels.size());
+    std::vector<geo::WireID> batchWires(nWires);
+    std::vector<std::size_t> offsets(channels.size() + 1);
+    table.ChannelsToWires(channels.data(), channels.size(),
+      batchWires.data(), offsets.data());
+    for (std::size_t i = 0; i < channels.size(); ++i) {
+      geo::ChannelMapTable::WireIDRange const wires
+        { batchWires.data() + offsets[i], batchWires.data() + offsets[i + 1] };
+      if (!sameWires(wires, channelWires[i]) && newError()) {
+        mf::LogError("GeometryTablesTest") << "ChannelsToWires(): "
+          << wires.size() << " wires for channel " << channels[i]
+          << ", " << channelWires[i].size()
+          << " from the geometry, or different wires";
+      }
+    } // for channels
+
+    std::vector<geo::View_t> views(channels.size());
+    table.ChannelsToViews(channels.data(), channels.size(), views.data());
+    for (std::size_t i = 0; i < channels.size(); ++i) {
+      if ((views[i] != geom.View(channels[i])) && newError()) {
+        mf::LogError("GeometryTablesTest") << "ChannelsToViews(): view "
+          << views[i] << " for channel " << channels[i] << ", "
+          << geom.View(channels[i]) << " from the geometry";
+      }
+    } // for channels
+
+    std::vector<raw::ChannelID_t> batchChannels(wireIDs.size());
+    table.WiresToChannels
+      (wireIDs.data(), wireIDs.size(), batchChannels.data());
+    for (std::size_t i = 0; i < wireIDs.size(); ++i) {
+      if ((batchChannels[i] != wireChannels[i]) && newError()) {
+        mf::LogError("GeometryTablesTest") << "WiresToChannels(): channel "
+          << batchChannels[i] << " for " << wireIDs[i] << ", "
+          << wireChannels[i] << " from the geometry";
+      }
+    } // for wires
+
+  } // GeometryTablesTest::checkChannelMapTable()
+
+
+  //......................................................................
+  void GeometryTablesTest::checkWireCrossings
+    (geo::GeometryCore const& geom, geo::WireGeometryTable const& table)
+  {
+    // sample of wire pairs from each pair of planes of each TPC
+    std::vector<geo::WireID> firstWires, secondWires;
+    for (geo::TPCID const& tpcid: geom.IterateTPCIDs()) {
+      unsigned int const nPlanes = geom.Nplanes(tpcid);
+      for (unsigned int first = 0; first < nPlanes; ++first) {
+        geo::PlaneID const firstPlane { tpcid, first };
+        std::size_t const nFirst = geom.Nwires(firstPlane);
+        for (unsigned int second = first + 1; second < nPlanes; ++second) {
+          geo::PlaneID const secondPlane { tpcid, second };
+          std::size_t const nSecond = geom.Nwires(secondPlane);
+          std::size_t const stride = std::max(
+            nFirst * nSecond / std::max(fWirePairsPerPlanePair, 1U),
+            std::size_t{ 1U }
+            );
+          for (std::size_t i = 0; i < nFirst * nSecond; i += stride) {
+            firstWires.emplace_back(firstPlane, i / nSecond);
+            secondWires.emplace_back(secondPlane, i % nSecond);
+          }
+        } // for second plane
+      } // for first plane
+    } // for TPC
+
+    std::size_t const nPairs = firstWires.size();
+    std::vector<double> y(nPairs), z(nPairs);
+    std::unique_ptr<bool[]> cross { new bool[nPairs] };
+    table.WireCrossings(firstWires.data(), secondWires.data(), nPairs,
+      y.data(), z.data(), cross.get());
+
+    for (std::size_t i = 0; i < nPairs; ++i) {
+      geo::WireID const& a = firstWires[i];
+      geo::WireID const& b = secondWires[i];
+      geo::WireIDIntersection crossing;
+      bool const expectedCross = geom.WireIDsIntersect(a, b, crossing);
+
+      // the crossing point is defined only for wires which are not parallel
+      bool const expectedFinite
+        = std::isfinite(crossing.y) && std::isfinite(crossing.z);
+      bool const finite = std::isfinite(y[i]) && std::isfinite(z[i]);
+      if (expectedFinite != finite) {
+        if (newError()) {
+          mf::LogError("GeometryTablesTest") << "WireCrossings(" << a << ", "
+            << b << "): point (" << y[i] << ", " << z[i]
+            << ") from the table, (" << crossing.y << ", " << crossing.z
+            << ") from the geometry";
+        }
+        continue;
+      }
+      if (!finite) {
+        if (cross[i] && newError()) {
+          mf::LogError("GeometryTablesTest") << "WireCrossings(" << a << ", "
+            << b << "): parallel wires reported as crossing by the table";
+        }
+        continue;
+      }
+
+      if (((std::abs(y[i] - crossing.y) > fTolerance)
+        || (std::abs(z[i] - crossing.z) > fTolerance))
+        && newError())
+      {
+        mf::LogError("GeometryTablesTest") << "WireCrossings(" << a << ", "
+          << b << "): point (" << y[i] << ", " << z[i]
+          << ") from the table, (" << crossing.y << ", " << crossing.z
+          << ") from the geometry";
+      }
+
+      // flags may differ only for crossings on the end of a wire
+      if (cross[i] == expectedCross) continue;
+      double const distance = std::min(
+        distanceFromEnd(geom.Wire(a), crossing.y, crossing.z),
+        distanceFromEnd(geom.Wire(b), crossing.y, crossing.z)
+        );
+      if ((distance > fTolerance) && newError()) {
+        mf::LogError("GeometryTablesTest") << "WireCrossings(" << a << ", "
+          << b << "): wires " << (cross[i]? "": "not ")
+          << "crossing according to the table, "
+          << (expectedCross? "": "not ") << "crossing according to the"
+          " geometry, " << distance << " cm away from the end of a wire";
+      }
+    } // for pairs
+
+    mf::LogInfo("GeometryTablesTest")
+      << "Wire crossings compared on " << nPairs << " pairs of wires";
+
+  } // GeometryTablesTest::checkWireCrossings()
+
+
+  //......................................................................
+  double GeometryTablesTest::distanceFromEnd
+    (geo::WireGeo const& wire, double y, double z)
+  {
+    auto const center = wire.GetCenter<geo::Point_t>();
+    auto const dir = wire.Direction<geo::Vector_t>();
+    double const dirYZ = std::hypot(dir.Y(), dir.Z());
+    double const s
+      = ((y - center.Y()) * dir.Y() + (z - center.Z()) * dir.Z()) / dirYZ;
+    return std::abs(std::abs(s) - wire.HalfL() * dirYZ);
+  } // GeometryTablesTest::distanceFromEnd()
+
+
+  //......................................................................
+  template <typename Range>
+  bool GeometryTablesTest::sameWires
+    (Range const& wires, std::vector<geo::WireID> const& expected)
+  {
+    if (wires.size() != expected.size()) return false;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+      if (wires[i] != expected[i]) return false;
+    return true;
+  } // GeometryTablesTest::sameWires()
+
+
+  //......................................................................
+  DEFINE_ART_MODULE(GeometryTablesTest)
+
+} // namespace geo
@@ -62,7 +62,7 @@ namespace geo {
     art::ServiceHandle<geo::Geometry const> geom;
 
     // 1. we set it up with the geometry from the environment
-    tester->Setup(*geom);
+    tester->Setup(*(geom->provider()));
 
     // 2. then we run it!
     tester->Run();
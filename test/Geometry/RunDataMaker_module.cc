@@ -0,0 +1,87 @@
+/**
+ * @file   RunDataMaker_module.cc
+ * @brief  Writes a `sumdata::RunData` with a configured detector in each run.
+ * @see    GeometryStressTest_module.cc
+ */
+
+// LArSoft includes
+#include "larcoreobj/SummaryData/RunData.h"
+
+// Framework includes
+#include "art/Framework/Core/EDProducer.h"
+#include "art/Framework/Core/ModuleMacros.h"
+#include "art/Framework/Principal/Event.h"
+#include "art/Framework/Principal/Run.h"
+#include "messagefacility/MessageLogger/MessageLogger.h"
+#include "fhiclcpp/ParameterSet.h"
+#include "cetlib_except/exception.h"
+
+// C/C++ standard library
+#include <memory> // std::make_unique()
+#include <string>
+#include <vector>
+#include <cstddef> // std::size_t
+
+
+namespace geo {
+
+  /**
+   * @brief Puts into each run a `sumdata::RunData` naming a detector.
+   *
+   * The detector names are taken in turn from the configured list, one per
+   * run. When the output of this module is read by a job with the
+   * geometry service, the geometry is reloaded at every run boundary
+   * (see `geo::Geometry`).
+   *
+   * Configuration parameters
+   * =========================
+   *
+   * - *DetectorNames* (list of strings, mandatory): the detector of each
+   *   run; after the last one, the list starts over
+   */
+  class RunDataMaker: public art::EDProducer {
+      public:
+    explicit RunDataMaker(fhicl::ParameterSet const& pset);
+
+    void beginRun(art::Run& run) override;
+    void produce(art::Event&) override {}
+
+      private:
+    std::vector<std::string> fDetectorNames; ///< Detector of each run.
+    std::size_t fNRuns = 0U; ///< Number of runs seen so far.
+
+  }; // class RunDataMaker
+
+} // namespace geo
+
+
+//******************************************************************************
+namespace geo {
+
+  //......................................................................
+  RunDataMaker::RunDataMaker(fhicl::ParameterSet const& pset)
+    : EDProducer(pset)
+    , fDetectorNames(pset.get<std::vector<std::string>>("DetectorNames"))
+  {
+    if (fDetectorNames.empty()) {
+      throw cet::exception("RunDataMaker")
+        << "No detector name configured (`DetectorNames`).\n";
+    }
+    produces<sumdata::RunData, art::InRun>();
+  } // RunDataMaker::RunDataMaker()
+
+
+  //......................................................................
+  void RunDataMaker::beginRun(art::Run& run) {
+    std::string const& detectorName
+      = fDetectorNames[fNRuns++ % fDetectorNames.size()];
+    mf::LogInfo("RunDataMaker")
+      << "Run " << run.run() << " is in detector '" << detectorName << "'";
+    run.put(std::make_unique<sumdata::RunData>(detectorName), art::fullRun());
+  } // RunDataMaker::beginRun()
+
+
+  //......................................................................
+  DEFINE_ART_MODULE(RunDataMaker)
+
+} // namespace geo
@@ -0,0 +1,35 @@
+#!/usr/bin/env bash
+#
+# File:    make_gdml_test.sh
+# Purpose: assembles the "bo" GDML fragments and compares the result with a
+#          reference description
+#
+# Usage:   make_gdml_test.sh <GDML source directory> <reference GDML file>
+#
+# The reference was produced by make_gdml.pl from the same fragments:
+# make_gdml is expected to reproduce its output exactly.
+#
+
+if [[ $# -ne 2 ]]; then
+  echo "Usage: $(basename "$0") <GDML source dir> <reference GDML file>" >&2
+  exit 1
+fi
+
+declare -r SourceDir="$1"
+declare -r ReferenceFile="$2"
+declare -r OutputFile="${PWD}/bo.gdml"
+
+# fragment paths in the configuration are relative to the GDML directory
+declare -r ConfigFile="bo-gdml-fragments.xml"
+if ! ( cd "$SourceDir" && make_gdml -i "$ConfigFile" -o "$OutputFile" ); then
+  echo "make_gdml failed to assemble the GDML fragments." >&2
+  exit 2
+fi
+
+if ! cmp "$OutputFile" "$ReferenceFile" ; then
+  diff "$OutputFile" "$ReferenceFile" | head -n 20 >&2
+  echo "The assembled GDML description differs from '${ReferenceFile}'." >&2
+  exit 3
+fi
+
+exit 0